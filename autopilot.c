@@ -0,0 +1,42 @@
+#include "autopilot.h"
+
+#include <math.h>
+
+// Maps an unfolded coordinate back between two walls, mirroring at each
+static float FoldBetween(float value, float low, float high) {
+    float span = high - low;
+    if (span <= 0.0f) return low;
+
+    float offset = fmodf(value - low, span * 2.0f);
+    if (offset < 0.0f) offset += span * 2.0f;
+    return (offset <= span) ? low + offset : high - (offset - span);
+}
+
+bool PredictBallCrossing(Vector2 position, Vector2 velocity, float radius, float lineY, float width,
+                         float *crossX, float *time) {
+    if (velocity.y == 0.0f) return false;
+
+    // Going up: travel to the ceiling, then all the way down from there
+    float distance = (velocity.y > 0.0f) ? lineY - position.y
+                                         : (position.y - radius) + (lineY - radius);
+    if (distance < 0.0f) distance = 0.0f;
+
+    float t = distance / fabsf(velocity.y);
+    *crossX = FoldBetween(position.x + velocity.x * t, radius, width - radius);
+    *time   = t;
+    return true;
+}
+
+float AimPaddleX(float crossX, float lineY, float paddleWidth, float ballSpeed, Vector2 target) {
+    // Straight up at full speed after the bounce, so the climb to the
+    // target takes rise / ballSpeed; pick the x speed that covers the gap
+    float rise = lineY - target.y;
+    if (rise < 1.0f) rise = 1.0f;
+    float vx = (target.x - crossX) * ballSpeed / rise;
+
+    // PaddleContactSystem: vx = (hitPos - 0.5) * 2 * ballSpeed
+    float hitPos = vx / (2.0f * ballSpeed) + 0.5f;
+    if (hitPos < 0.05f) hitPos = 0.05f;
+    if (hitPos > 0.95f) hitPos = 0.95f;
+    return crossX - hitPos * paddleWidth;
+}
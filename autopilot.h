@@ -0,0 +1,27 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+// ----------------------------------------------------------------------
+//  Paddle autopilot: analytic ball prediction and aiming
+//
+//  Prediction follows the ball in a straight line and folds the path back
+//  at the side walls and the ceiling, so it costs the same however many
+//  bounces lie ahead. Blocks are not considered; a ball that hits one on
+//  the way changes course and simply gets predicted again next frame.
+// ----------------------------------------------------------------------
+
+// Where the ball's centre reaches lineY, walls at 0 and width. Balls going
+// up are followed off the ceiling first. Returns false for a ball that
+// never gets there (no vertical speed).
+bool PredictBallCrossing(Vector2 position, Vector2 velocity, float radius, float lineY, float width,
+                         float *crossX, float *time);
+
+// Left edge the paddle should have when the ball lands at crossX, so the
+// bounce (outgoing x speed set by where it hits, as in PaddleContactSystem)
+// heads for target. Hits stay inside the middle 90% of the paddle.
+float AimPaddleX(float crossX, float lineY, float paddleWidth, float ballSpeed, Vector2 target);
+
+#endif // AUTOPILOT_H
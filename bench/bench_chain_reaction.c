@@ -0,0 +1,107 @@
+// ----------------------------------------------------------------------
+//  Worst-case chain reaction: every block of a 1M-block level is
+//  explosive and one blast in the middle sets off all of them
+//
+//  usage: bench_chain_reaction [rows] [cols]
+//  Runs the grid path and the custom-rect (column index) path at a few
+//  per-tick budgets and reports the slowest tick, which is what the
+//  player would feel as a frame spike.
+// ----------------------------------------------------------------------
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "raylib.h"
+#include "level.h"
+#include "column_index.h"
+#include "chain_reaction.h"
+#include "platform.h"
+
+typedef struct BenchState {
+    LevelData *level;
+    ChainReaction *chain;
+    int destroyed;
+} BenchState;
+
+static void BenchDamage(void *userData, int index) {
+    BenchState *state = (BenchState *)userData;
+    Block *block = &state->level->blocks[index];
+    if (!block->active) return;
+
+    block->health--;
+    if (block->health <= 0) {
+        block->active = false;
+        state->destroyed++;
+        if (block->type == BLOCK_EXPLOSIVE) IgniteBlock(state->chain, index);
+    }
+}
+
+static void ArmLevel(LevelData *level) {
+    for (int i = 0; i < level->blockCount; i++) {
+        level->blocks[i].active = true;
+        level->blocks[i].health = 1;
+        level->blocks[i].type   = BLOCK_EXPLOSIVE;
+    }
+}
+
+static void RunChain(LevelData *level, const ColumnIndex *columns, int budget, const char *label) {
+    ChainReaction chain;
+    ArmLevel(level);
+    if (!InitChainReaction(&chain, level->blockCount)) {
+        printf("%s: out of memory\n", label);
+        return;
+    }
+
+    BenchState state = { level, &chain, 0 };
+    int centre = (level->rows / 2) * level->cols + level->cols / 2;
+    BenchDamage(&state, centre);
+
+    int ticks = 0;
+    double worstTick = 0.0;
+    double start = NowSeconds();
+    while (IsChainReactionActive(&chain)) {
+        double tickStart = NowSeconds();
+        StepChainReaction(&chain, level, columns, budget, BenchDamage, &state);
+        double tick = NowSeconds() - tickStart;
+        if (tick > worstTick) worstTick = tick;
+        ticks++;
+    }
+    double total = NowSeconds() - start;
+
+    printf("%-12s budget %8s   %8d ticks   total %8.1f ms   worst tick %8.3f ms   %6.1f ns/block\n",
+           label, (budget == INT_MAX) ? "none" : TextFormat("%d", budget), ticks,
+           total * 1000.0, worstTick * 1000.0, total * 1e9 / state.destroyed);
+
+    if (state.destroyed != level->blockCount) {
+        printf("  only %d of %d blocks went off\n", state.destroyed, level->blockCount);
+    }
+    FreeChainReaction(&chain);
+}
+
+int main(int argc, char **argv) {
+    int rows = (argc > 1) ? atoi(argv[1]) : 1000;
+    int cols = (argc > 2) ? atoi(argv[2]) : 1000;
+    const int budgets[] = { CHAIN_REACTION_BUDGET, 4096, INT_MAX };
+    const int budgetCount = (int)(sizeof(budgets) / sizeof(budgets[0]));
+
+    LevelData level;
+    if (!GenerateLevel(&level, rows, cols, 1)) {
+        printf("Failed to generate a %dx%d level\n", rows, cols);
+        return 1;
+    }
+    printf("%d blocks (%dx%d)\n", level.blockCount, rows, cols);
+
+    ColumnIndex columns;
+    double start = NowSeconds();
+    BuildColumnIndex(&columns, &level);
+    printf("column index built in %.1f ms\n", (NowSeconds() - start) * 1000.0);
+
+    for (int b = 0; b < budgetCount; b++) RunChain(&level, &columns, budgets[b], "grid");
+
+    // Same blocks, but neighbours found through the column index
+    level.flags |= LEVEL_FLAG_CUSTOM_RECTS;
+    for (int b = 0; b < budgetCount; b++) RunChain(&level, &columns, budgets[b], "custom rects");
+
+    FreeColumnIndex(&columns);
+    UnloadLevel(&level);
+    return 0;
+}
@@ -0,0 +1,133 @@
+// ----------------------------------------------------------------------
+//  Fixed-point ball physics against the float path it replaces
+//
+//  usage: bench_fixed_physics [balls] [ticks] [rows] [cols]
+//  Both runs do what UpdateGame does to every ball each tick: move,
+//  bounce off the walls, look for a block to hit (the full scan of
+//  CheckBlockCollision) and test the paddle. Blocks are never destroyed,
+//  so every tick costs the same. The fixed run goes twice to show it ends
+//  in the same bits.
+// ----------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "raylib.h"
+#include "level.h"
+#include "fixed_physics.h"
+#include "checksum.h"
+#include "rng.h"
+#include "platform.h"
+
+#define SCREEN_WIDTH  1800.0f
+#define SCREEN_HEIGHT 900.0f
+#define BALL_SPEED    1000.0f
+#define BALL_RADIUS   8.0f
+#define TICK          (1.0f / 120.0f)
+
+typedef struct Balls {
+    Vector2 *position;
+    Vector2 *velocity;
+    int count;
+} Balls;
+
+static void ResetBalls(Balls *balls) {
+    RandomStream rng;
+    SeedRandomStream(&rng, 1, 0);
+    for (int i = 0; i < balls->count; i++) {
+        balls->position[i] = (Vector2){ (float)RandomValue(&rng, 10, 1790), (float)RandomValue(&rng, 450, 700) };
+        balls->velocity[i] = FixedAngleVelocity(RandomValue(&rng, 200, 340), BALL_SPEED);
+    }
+}
+
+static void StepFloat(Balls *balls, const LevelData *level, Rectangle paddle) {
+    for (int i = 0; i < balls->count; i++) {
+        Vector2 *p = &balls->position[i];
+        Vector2 *v = &balls->velocity[i];
+        p->x += v->x * TICK;
+        p->y += v->y * TICK;
+        if ((p->x - BALL_RADIUS <= 0 && v->x < 0) || (p->x + BALL_RADIUS >= SCREEN_WIDTH && v->x > 0)) v->x *= -1.0f;
+        if (p->y - BALL_RADIUS <= 0 && v->y < 0) v->y *= -1.0f;
+        if (p->y + BALL_RADIUS >= SCREEN_HEIGHT && v->y > 0) v->y *= -1.0f;    // floor instead of losing it
+
+        if (CheckCollisionCircleRec(*p, BALL_RADIUS, paddle)) {
+            float hitPos = (p->x - paddle.x) / paddle.width;
+            v->y = -BALL_SPEED;
+            v->x = (hitPos - 0.5f) * BALL_SPEED * 2.0f;
+        }
+        for (int b = 0; b < level->blockCount; b++) {
+            if (level->blocks[b].active && CheckCollisionCircleRec(*p, BALL_RADIUS, level->blocks[b].rect)) {
+                v->y *= -1.0f;
+                break;
+            }
+        }
+    }
+}
+
+static void StepFixed(Balls *balls, const LevelData *level, Rectangle paddle, int32_t step) {
+    for (int i = 0; i < balls->count; i++) {
+        Vector2 *p = &balls->position[i];
+        Vector2 *v = &balls->velocity[i];
+        if (FixedMoveBall(p, v, BALL_RADIUS, SCREEN_WIDTH, SCREEN_HEIGHT, step) && v->y > 0) v->y *= -1.0f;
+
+        FixedCircle circle = ToFixedCircle(*p, BALL_RADIUS);
+        if (FixedCircleTouchesRect(circle, paddle)) FixedPaddleBounce(*p, v, paddle, BALL_SPEED);
+        for (int b = 0; b < level->blockCount; b++) {
+            if (level->blocks[b].active && FixedCircleTouchesRect(circle, level->blocks[b].rect)) {
+                v->y *= -1.0f;
+                break;
+            }
+        }
+    }
+}
+
+static uint32_t StateChecksum(const Balls *balls) {
+    uint32_t crc = Crc32(0, balls->position, sizeof(Vector2) * balls->count);
+    return Crc32(crc, balls->velocity, sizeof(Vector2) * balls->count);
+}
+
+static double Run(Balls *balls, const LevelData *level, int ticks, bool fixed, uint32_t *checksum) {
+    Rectangle paddle = { SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT - 150.0f, SCREEN_WIDTH / 20.0f, SCREEN_HEIGHT / 50.0f };
+    int32_t step = ToFixedTime(TICK);
+    ResetBalls(balls);
+
+    double start = NowSeconds();
+    for (int t = 0; t < ticks; t++) {
+        if (fixed) StepFixed(balls, level, paddle, step);
+        else       StepFloat(balls, level, paddle);
+    }
+    double elapsed = NowSeconds() - start;
+    *checksum = StateChecksum(balls);
+    return elapsed;
+}
+
+int main(int argc, char **argv) {
+    int count = (argc > 1) ? atoi(argv[1]) : 4096;
+    int ticks = (argc > 2) ? atoi(argv[2]) : 600;
+    int rows  = (argc > 3) ? atoi(argv[3]) : 4;
+    int cols  = (argc > 4) ? atoi(argv[4]) : 14;
+
+    LevelData level;
+    Balls balls = { malloc(sizeof(Vector2) * count), malloc(sizeof(Vector2) * count), count };
+    if (!balls.position || !balls.velocity || !GenerateLevel(&level, rows, cols, 1)) {
+        printf("Failed to set up %d balls\n", count);
+        return 1;
+    }
+    printf("%d balls, %d blocks (%dx%d), %d ticks\n", count, level.blockCount, rows, cols, ticks);
+
+    uint32_t floatSum, fixedSum, fixedAgain;
+    double floatTime = Run(&balls, &level, ticks, false, &floatSum);
+    double fixedTime = Run(&balls, &level, ticks, true, &fixedSum);
+    Run(&balls, &level, ticks, true, &fixedAgain);
+
+    double steps = (double)count * ticks;
+    printf("float   %8.2f ns/ball-tick   %8.1f M ball-ticks/s   state %08x\n",
+           floatTime * 1e9 / steps, steps / floatTime / 1e6, floatSum);
+    printf("fixed   %8.2f ns/ball-tick   %8.1f M ball-ticks/s   state %08x (%s on rerun)\n",
+           fixedTime * 1e9 / steps, steps / fixedTime / 1e6, fixedSum,
+           (fixedSum == fixedAgain) ? "same" : "DIFFERENT");
+
+    UnloadLevel(&level);
+    free(balls.position);
+    free(balls.velocity);
+    return (fixedSum == fixedAgain) ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+// ----------------------------------------------------------------------
+//  Cold and warm load times of a 1,000-level pack
+//
+//  usage: bench_level_pack [packDir] [levelCount] [rows] [cols]
+//  The pack is generated on the first run. "Cold" asks the OS to drop the
+//  files from the page cache first (POSIX only; best effort elsewhere).
+// ----------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include "raylib.h"
+#include "level.h"
+#include "level_pack.h"
+#include "platform.h"
+
+#if defined(_WIN32)
+    #include <direct.h>
+#else
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+static void MakeDirectory(const char *path) {
+#if defined(_WIN32)
+    _mkdir(path);
+#else
+    mkdir(path, 0755);
+#endif
+}
+
+static void WritePack(const char *dir, int count, int rows, int cols) {
+    MakeDirectory(dir);
+    for (int i = 0; i < count; i++) {
+        LevelData level;
+        GenerateLevel(&level, rows, cols, (uint32_t)i);
+        SaveLevelFile(TextFormat("%s/level_%04d" LEVEL_FILE_EXTENSION, dir, i), &level);
+        UnloadLevel(&level);
+    }
+}
+
+static void DropFromCache(const LevelPack *pack) {
+#if defined(POSIX_FADV_DONTNEED)
+    for (int i = 0; i < pack->count; i++) {
+        int fd = open(LevelPackPath(pack, i), O_RDONLY);
+        if (fd < 0) continue;
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#else
+    (void)pack;
+#endif
+}
+
+static double TimeLoad(const char *dir, JobPool *pool, LevelPack *pack) {
+    double start = NowSeconds();
+    LoadLevelPack(dir, pool, pack);
+    return (NowSeconds() - start) * 1000.0;
+}
+
+int main(int argc, char **argv) {
+    const char *dir = (argc > 1) ? argv[1] : "bench_pack";
+    int count       = (argc > 2) ? atoi(argv[2]) : 1000;
+    int rows        = (argc > 3) ? atoi(argv[3]) : 40;
+    int cols        = (argc > 4) ? atoi(argv[4]) : 40;
+    const int warmRuns = 5;
+
+    LevelPack pack;
+    JobPool single, pool;
+    InitJobPool(&single, 0);          // calling thread only
+    InitJobPool(&pool, -1);
+
+    if (!LoadLevelPack(dir, &pool, &pack) || pack.count < count) {
+        printf("Writing %d levels of %dx%d to %s...\n", count, rows, cols, dir);
+        UnloadLevelPack(&pack);
+        WritePack(dir, count, rows, cols);
+        if (!LoadLevelPack(dir, &pool, &pack) || pack.count == 0) {
+            printf("Failed to write a level pack to %s\n", dir);
+            UnloadLevelPack(&pack);
+            ShutdownJobPool(&single);
+            ShutdownJobPool(&pool);
+            return 1;
+        }
+    }
+    printf("Pack: %d levels, %d blocks each, %d worker threads + caller\n",
+           pack.count, (int)pack.entries[0].blockCount, pool.threadCount);
+
+    JobPool *pools[2]        = { &single, &pool };
+    const char *poolNames[2] = { "1 thread ", "parallel " };
+    for (int p = 0; p < 2; p++) {
+        DropFromCache(&pack);
+        UnloadLevelPack(&pack);
+        double cold = TimeLoad(dir, pools[p], &pack);
+
+        double warm = 0.0;
+        for (int run = 0; run < warmRuns; run++) {
+            UnloadLevelPack(&pack);
+            warm += TimeLoad(dir, pools[p], &pack);
+        }
+        warm /= warmRuns;
+
+        printf("%s cold %8.2f ms   warm %8.2f ms   (%.0f levels/s warm)\n",
+               poolNames[p], cold, warm, pack.count / (warm / 1000.0));
+    }
+
+    // Switching levels in game: map the next entry, nothing else
+    double start = NowSeconds();
+    for (int i = 0; i < pack.count; i++) {
+        LevelData level;
+        LoadLevelFile(LevelPackPath(&pack, i), &level);
+        UnloadLevel(&level);
+    }
+    printf("level switch   %8.2f us average\n", (NowSeconds() - start) * 1e6 / pack.count);
+
+    UnloadLevelPack(&pack);
+    ShutdownJobPool(&pool);
+    ShutdownJobPool(&single);
+    return 0;
+}
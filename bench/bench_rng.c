@@ -0,0 +1,106 @@
+// ----------------------------------------------------------------------
+//  Seeded random streams against raylib's GetRandomValue
+//
+//  usage: bench_rng [draws] [levels] [rows] [cols]
+//  Single-threaded throughput for the rolls the game makes (1-3 health,
+//  0-359 degrees), then a batch of levels generated in parallel on the
+//  job pool, twice, to show the same seeds give the same levels however
+//  the threads pick them up.
+// ----------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include "raylib.h"
+#include "level.h"
+#include "rng.h"
+#include "checksum.h"
+#include "job_pool.h"
+#include "platform.h"
+
+static volatile int sink;
+
+static void TimeGetRandomValue(int draws, int min, int max) {
+    int sum = 0;
+    double start = NowSeconds();
+    for (int i = 0; i < draws; i++) sum += GetRandomValue(min, max);
+    double elapsed = NowSeconds() - start;
+    sink = sum;
+    printf("%-24s %8.2f ns/draw   %8.1f M draws/s\n",
+           TextFormat("GetRandomValue(%d, %d)", min, max), elapsed * 1e9 / draws, draws / elapsed / 1e6);
+}
+
+static void TimeRandomValue(int draws, int min, int max) {
+    RandomStream rng;
+    SeedRandomStream(&rng, 1, RANDOM_STREAM_LEVEL);
+    int sum = 0;
+    double start = NowSeconds();
+    for (int i = 0; i < draws; i++) sum += RandomValue(&rng, min, max);
+    double elapsed = NowSeconds() - start;
+    sink = sum;
+    printf("%-24s %8.2f ns/draw   %8.1f M draws/s\n",
+           TextFormat("RandomValue(%d, %d)", min, max), elapsed * 1e9 / draws, draws / elapsed / 1e6);
+}
+
+// ----------------------------------------------------------------------
+//  Parallel generation: one level per job, seed derived from its index
+// ----------------------------------------------------------------------
+typedef struct LevelBatch {
+    int rows;
+    int cols;
+    uint32_t *checksums;
+} LevelBatch;
+
+static void GenerateOne(void *userData, int index) {
+    LevelBatch *batch = (LevelBatch *)userData;
+    LevelData level;
+    if (!GenerateLevel(&level, batch->rows, batch->cols, DeriveSeed(1, (uint32_t)index))) {
+        batch->checksums[index] = 0;
+        return;
+    }
+    batch->checksums[index] = Crc32(0, level.blocks, sizeof(Block) * level.blockCount);
+    UnloadLevel(&level);
+}
+
+static double GenerateAll(JobPool *pool, LevelBatch *batch, int levels) {
+    double start = NowSeconds();
+    ParallelFor(pool, levels, GenerateOne, batch);
+    return NowSeconds() - start;
+}
+
+int main(int argc, char **argv) {
+    int draws  = (argc > 1) ? atoi(argv[1]) : 50000000;
+    int levels = (argc > 2) ? atoi(argv[2]) : 2000;
+    int rows   = (argc > 3) ? atoi(argv[3]) : 16;
+    int cols   = (argc > 4) ? atoi(argv[4]) : 14;
+
+    SetRandomSeed(1);
+    TimeGetRandomValue(draws, 1, 3);
+    TimeRandomValue(draws, 1, 3);
+    TimeGetRandomValue(draws, 0, 359);
+    TimeRandomValue(draws, 0, 359);
+
+    JobPool pool;
+    uint32_t *first  = malloc(sizeof(uint32_t) * levels);
+    uint32_t *second = malloc(sizeof(uint32_t) * levels);
+    if (!first || !second || !InitJobPool(&pool, -1)) {
+        printf("Failed to set up %d levels\n", levels);
+        free(first);
+        free(second);
+        return 1;
+    }
+
+    LevelBatch batch = { rows, cols, first };
+    double elapsed = GenerateAll(&pool, &batch, levels);
+    batch.checksums = second;
+    GenerateAll(&pool, &batch, levels);
+
+    int mismatches = 0;
+    for (int i = 0; i < levels; i++) mismatches += (first[i] != second[i]);
+    printf("%d levels of %dx%d on %d threads   %.1f ms   %.1f us/level   %s\n",
+           levels, rows, cols, pool.threadCount + 1, elapsed * 1000.0, elapsed * 1e6 / levels,
+           mismatches ? "DIFFERENT between runs" : "identical between runs");
+
+    ShutdownJobPool(&pool);
+    free(first);
+    free(second);
+    return mismatches ? 1 : 0;
+}
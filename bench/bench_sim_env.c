@@ -0,0 +1,71 @@
+// ----------------------------------------------------------------------
+//  Vectorized environment throughput with random actions
+//
+//  usage: bench_sim_env [envs] [rows] [cols] [steps]
+//  Steps every environment the given number of times, on the calling
+//  thread alone and then on every CPU, and once more swapping between
+//  two observation buffers so every step rewrites the whole row.
+// ----------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include "sim_env.h"
+#include "platform.h"
+
+static RandomStream benchRandom;
+
+static void RunSteps(int envs, const SimConfig *config, int steps, int threads, bool swapBuffers) {
+    SimEnv *env = CreateSimEnv(envs, config, 1, threads);
+    SeedRandomStream(&benchRandom, 1, 0);
+    if (!env) {
+        printf("Failed to create %d environments\n", envs);
+        return;
+    }
+
+    size_t rowSize   = (size_t)SimEnvObservationSize(env);
+    float *obs[2]    = { malloc(sizeof(float) * rowSize * envs), malloc(sizeof(float) * rowSize * envs) };
+    float *rewards   = malloc(sizeof(float) * envs);
+    uint8_t *dones   = malloc(envs);
+    uint8_t *actions = malloc(envs);
+    if (!obs[0] || !obs[1] || !rewards || !dones || !actions) {
+        printf("Failed to allocate buffers\n");
+    }
+    else {
+        ResetSimEnv(env, obs[0]);
+        long episodes = 0;
+        double start  = NowSeconds();
+        for (int s = 0; s < steps; s++) {
+            for (int i = 0; i < envs; i++) actions[i] = (uint8_t)(NextRandom(&benchRandom) % SIM_ACTION_COUNT);
+            StepSimEnv(env, actions, obs[swapBuffers ? (s & 1) : 0], rewards, dones);
+            for (int i = 0; i < envs; i++) episodes += dones[i];
+        }
+        double elapsed = NowSeconds() - start;
+
+        printf("%-8s %-12s %8.2f M steps/s   %zu floats per observation   %ld episodes finished\n",
+               (threads == 0) ? "1 thread" : "all CPUs", swapBuffers ? "two buffers" : "one buffer",
+               (double)envs * steps / elapsed / 1e6, rowSize, episodes);
+    }
+
+    free(obs[0]);
+    free(obs[1]);
+    free(rewards);
+    free(dones);
+    free(actions);
+    DestroySimEnv(env);
+}
+
+int main(int argc, char **argv) {
+    int envs         = (argc > 1) ? atoi(argv[1]) : 4096;
+    SimConfig config = { 0 };
+    config.rows      = (argc > 2) ? atoi(argv[2]) : 2;
+    config.cols      = (argc > 3) ? atoi(argv[3]) : 14;
+    int steps        = (argc > 4) ? atoi(argv[4]) : 2000;
+    config.startHP   = 10;
+    config.maxTicks  = 60 * SIM_TICK_RATE;
+
+    printf("%d environments of %dx%d blocks, %d steps, %d CPUs\n",
+           envs, config.rows, config.cols, steps, GetCpuCount());
+    RunSteps(envs, &config, steps, 0, false);
+    RunSteps(envs, &config, steps, -1, false);
+    RunSteps(envs, &config, steps, -1, true);
+    return 0;
+}
@@ -0,0 +1,113 @@
+// ----------------------------------------------------------------------
+//  Per-tick world hashing: xxHash32 against the Crc32 level files use
+//
+//  usage: bench_state_hash [balls] [ticks] [rows] [cols]
+//  Hashes a full block array plus positions and velocities for the balls,
+//  fed in the pieces the game feeds them in. "digest" is what
+//  HashWorldState does every frame instead: the balls and the running
+//  block digest, with one block hit per tick to keep it current.
+// ----------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include "raylib.h"
+#include "level.h"
+#include "ecs.h"
+#include "checksum.h"
+#include "platform.h"
+
+static volatile uint32_t sink;
+
+typedef struct WorldBuffers {
+    LevelData *level;
+    Vector2 *position;
+    Vector2 *velocity;
+    int count;
+    uint32_t blockDigest;
+    int nextHit;
+} WorldBuffers;
+
+// BlockHashTerm in main.c
+static uint32_t BlockHashTerm(const LevelData *level, int index) {
+    int32_t state[2] = { level->blocks[index].health, level->blocks[index].active };
+    return Hash32((uint32_t)index, state, sizeof(state));
+}
+
+static uint32_t CrcWorld(WorldBuffers *w) {
+    uint32_t crc = Crc32(0, w->level->blocks, sizeof(Block) * w->level->blockCount);
+    for (int at = 0; at < w->count; at += ECS_CHUNK_CAPACITY) {
+        int n = (w->count - at < ECS_CHUNK_CAPACITY) ? w->count - at : ECS_CHUNK_CAPACITY;
+        crc = Crc32(crc, w->position + at, sizeof(Vector2) * n);
+        crc = Crc32(crc, w->velocity + at, sizeof(Vector2) * n);
+    }
+    return crc;
+}
+
+static uint32_t HashWorld(WorldBuffers *w) {
+    HashState hash;
+    BeginHash(&hash, 0);
+    UpdateHash(&hash, w->level->blocks, sizeof(Block) * w->level->blockCount);
+    for (int at = 0; at < w->count; at += ECS_CHUNK_CAPACITY) {
+        int n = (w->count - at < ECS_CHUNK_CAPACITY) ? w->count - at : ECS_CHUNK_CAPACITY;
+        UpdateHash(&hash, w->position + at, sizeof(Vector2) * n);
+        UpdateHash(&hash, w->velocity + at, sizeof(Vector2) * n);
+    }
+    return FinishHash(&hash);
+}
+
+static uint32_t DigestWorld(WorldBuffers *w) {
+    int index = w->nextHit;
+    w->nextHit = (w->nextHit + 1) % w->level->blockCount;
+    w->blockDigest ^= BlockHashTerm(w->level, index);
+    w->level->blocks[index].health ^= 1;
+    w->blockDigest ^= BlockHashTerm(w->level, index);
+
+    HashState hash;
+    BeginHash(&hash, 0);
+    UpdateHash(&hash, &w->blockDigest, sizeof(w->blockDigest));
+    for (int at = 0; at < w->count; at += ECS_CHUNK_CAPACITY) {
+        int n = (w->count - at < ECS_CHUNK_CAPACITY) ? w->count - at : ECS_CHUNK_CAPACITY;
+        UpdateHash(&hash, w->position + at, sizeof(Vector2) * n);
+        UpdateHash(&hash, w->velocity + at, sizeof(Vector2) * n);
+    }
+    return FinishHash(&hash);
+}
+
+static void Time(const char *label, uint32_t (*hashWorld)(WorldBuffers *), WorldBuffers *w, int ticks, size_t bytes) {
+    uint32_t result = 0;
+    double start = NowSeconds();
+    for (int t = 0; t < ticks; t++) result ^= hashWorld(w);
+    double elapsed = NowSeconds() - start;
+    sink = result;
+    printf("%-8s %8.2f us/tick   %6.2f GB/s\n", label, elapsed * 1e6 / ticks, bytes * (double)ticks / elapsed / 1e9);
+}
+
+int main(int argc, char **argv) {
+    int count = (argc > 1) ? atoi(argv[1]) : 512;
+    int ticks = (argc > 2) ? atoi(argv[2]) : 20000;
+    int rows  = (argc > 3) ? atoi(argv[3]) : 14;
+    int cols  = (argc > 4) ? atoi(argv[4]) : 14;
+
+    LevelData level;
+    WorldBuffers w = { &level, malloc(sizeof(Vector2) * count), malloc(sizeof(Vector2) * count), count, 0, 0 };
+    if (!w.position || !w.velocity || !GenerateLevel(&level, rows, cols, 1)) {
+        printf("Failed to set up %d balls\n", count);
+        return 1;
+    }
+    for (int i = 0; i < count; i++) {
+        w.position[i] = (Vector2){ (float)(i % 1800), (float)(i % 900) };
+        w.velocity[i] = (Vector2){ 600.0f, -800.0f };
+    }
+
+    for (int i = 0; i < level.blockCount; i++) w.blockDigest ^= BlockHashTerm(&level, i);
+
+    size_t bytes = sizeof(Block) * level.blockCount + 2 * sizeof(Vector2) * count;
+    printf("%d blocks (%dx%d), %d balls: %zu bytes a tick, %d ticks\n", level.blockCount, rows, cols, count, bytes, ticks);
+    Time("Crc32", CrcWorld, &w, ticks, bytes);
+    Time("xxHash32", HashWorld, &w, ticks, bytes);
+    Time("digest", DigestWorld, &w, ticks, sizeof(uint32_t) + 2 * sizeof(Vector2) * count);
+
+    UnloadLevel(&level);
+    free(w.position);
+    free(w.velocity);
+    return 0;
+}
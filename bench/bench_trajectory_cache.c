@@ -0,0 +1,122 @@
+// ----------------------------------------------------------------------
+//  Predicted paths for 10k balls, cached against recomputed every frame
+//
+//  usage: bench_trajectory_cache [balls] [frames] [rows] [cols]
+//  The balls fly along their own predicted paths, so both runs see the
+//  same motion. Every frame one block is destroyed and balls reaching the
+//  paddle line bounce back up; every second a block comes back. The
+//  cached run predicts only what those events and passed bounces made
+//  stale, the other predicts every ball every frame.
+// ----------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include "raylib.h"
+#include "level.h"
+#include "trajectory_cache.h"
+#include "rng.h"
+#include "platform.h"
+
+#define SCREEN_WIDTH  1800
+#define SCREEN_HEIGHT 900
+#define BALL_SPEED    1000.0f
+#define BALL_RADIUS   8.0f
+#define LINE_Y        (SCREEN_HEIGHT - 150.0f - BALL_RADIUS)
+#define FRAME_TIME    (1.0 / 60.0)
+
+static RandomStream benchRandom;
+
+static float RandomRange(float low, float high) {
+    return low + (high - low) * (float)(NextRandom(&benchRandom) >> 8) / (float)0x1000000;
+}
+
+static void ArmLevel(LevelData *level) {
+    for (int i = 0; i < level->blockCount; i++) {
+        level->blocks[i].active = true;
+        level->blocks[i].health = 1;
+    }
+}
+
+static void RunFrames(LevelData *level, int balls, int frames, bool cached, const char *label) {
+    TrajectoryCache cache;
+    if (!InitTrajectoryCache(&cache, balls, level, SCREEN_WIDTH, LINE_Y, TRAJECTORY_MAX_BOUNCES)) {
+        printf("%s: out of memory\n", label);
+        return;
+    }
+    ArmLevel(level);
+    SeedRandomStream(&benchRandom, 1, 0);
+
+    // Everyone starts below the blocks heading up at some angle
+    for (int b = 0; b < balls; b++) {
+        Vector2 position = { RandomRange(BALL_RADIUS, SCREEN_WIDTH - BALL_RADIUS), RandomRange(450.0f, LINE_Y - 1.0f) };
+        float vx = RandomRange(-0.9f, 0.9f) * BALL_SPEED;
+        PredictTrajectory(&cache, b, b + 1, level, position, (Vector2){ vx, -BALL_SPEED }, BALL_RADIUS, 0.0);
+    }
+    ResetTrajectoryStats(&cache);
+
+    int destroyed = 0, returned = 0, paddleHits = 0;
+    double worstFrame = 0.0;
+    double start = NowSeconds();
+    for (int frame = 1; frame <= frames; frame++) {
+        double now = frame * FRAME_TIME;
+        double frameStart = NowSeconds();
+
+        int block = (int)(NextRandom(&benchRandom) % (uint32_t)level->blockCount);
+        if (level->blocks[block].active) {
+            level->blocks[block].active = false;
+            InvalidateBlockTrajectories(&cache, level, block);
+            destroyed++;
+        }
+        if (frame % 60 == 0) {
+            int back = (int)(NextRandom(&benchRandom) % (uint32_t)level->blockCount);
+            if (!level->blocks[back].active) {
+                level->blocks[back].active = true;
+                InvalidateBlockTrajectories(&cache, level, back);
+                returned++;
+            }
+        }
+
+        for (int b = 0; b < balls; b++) {
+            const TrajectoryPath *path = &cache.paths[b];
+            if (cached && GetTrajectory(&cache, b, b + 1, now)) continue;
+
+            Vector2 position, velocity;
+            TrajectoryStateAt(path, now, &position, &velocity);
+            if (path->reachesLine && now >= path->startTime + path->times[path->pointCount - 1]) {
+                velocity = (Vector2){ RandomRange(-0.9f, 0.9f) * BALL_SPEED, -BALL_SPEED };
+                paddleHits++;
+            }
+            PredictTrajectory(&cache, b, b + 1, level, position, velocity, BALL_RADIUS, now);
+        }
+
+        double elapsed = NowSeconds() - frameStart;
+        if (elapsed > worstFrame) worstFrame = elapsed;
+    }
+    double total = NowSeconds() - start;
+
+    printf("%-14s %8.3f ms/frame   worst %8.3f ms   %8.1f predictions/frame   %6.1f invalidated/frame\n",
+           label, total * 1000.0 / frames, worstFrame * 1000.0,
+           (double)cache.predictions / frames, (double)cache.invalidations / frames);
+    printf("%-14s %d blocks destroyed, %d came back, %d paddle bounces\n", "", destroyed, returned, paddleHits);
+    FreeTrajectoryCache(&cache);
+}
+
+int main(int argc, char **argv) {
+    int balls  = (argc > 1) ? atoi(argv[1]) : 10000;
+    int frames = (argc > 2) ? atoi(argv[2]) : 600;
+    int rows   = (argc > 3) ? atoi(argv[3]) : 8;
+    int cols   = (argc > 4) ? atoi(argv[4]) : 14;
+
+    LevelData level;
+    if (!GenerateLevel(&level, rows, cols, 1)) {
+        printf("Failed to generate a %dx%d level\n", rows, cols);
+        return 1;
+    }
+    printf("%d balls, %d blocks (%dx%d), %d frames, up to %d bounces ahead\n",
+           balls, level.blockCount, rows, cols, frames, TRAJECTORY_MAX_BOUNCES);
+
+    RunFrames(&level, balls, frames, false, "every frame");
+    RunFrames(&level, balls, frames, true, "cached");
+
+    UnloadLevel(&level);
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include "chain_reaction.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+bool InitChainReaction(ChainReaction *chain, int blockCount) {
+    memset(chain, 0, sizeof(*chain));
+    if (blockCount <= 0) return true;
+
+    chain->queue   = malloc(sizeof(int) * blockCount);
+    chain->ignited = calloc(blockCount, 1);
+    if (!chain->queue || !chain->ignited) {
+        FreeChainReaction(chain);
+        return false;
+    }
+    chain->blockCount = blockCount;
+    return true;
+}
+
+void FreeChainReaction(ChainReaction *chain) {
+    free(chain->queue);
+    free(chain->ignited);
+    memset(chain, 0, sizeof(*chain));
+}
+
+void ClearChainReaction(ChainReaction *chain) {
+    if (chain->ignited) memset(chain->ignited, 0, (size_t)chain->blockCount);
+    chain->head   = 0;
+    chain->tail   = 0;
+    chain->queued = 0;
+}
+
+void IgniteBlock(ChainReaction *chain, int blockIndex) {
+    if (blockIndex < 0 || blockIndex >= chain->blockCount || chain->ignited[blockIndex]) return;
+    chain->ignited[blockIndex] = 1;
+    chain->queue[chain->tail] = blockIndex;
+    chain->tail = (chain->tail + 1) % chain->blockCount;
+    chain->queued++;
+}
+
+bool IsChainReactionActive(const ChainReaction *chain) {
+    return chain->queued > 0;
+}
+
+// Blocks laid out by GenerateLevel: row-major, one per cell
+static bool IsGridLevel(const LevelData *level) {
+    return !(level->flags & LEVEL_FLAG_CUSTOM_RECTS) &&
+           level->rows > 0 && level->cols > 0 &&
+           (long long)level->rows * level->cols == level->blockCount;
+}
+
+static void BlastGrid(const LevelData *level, int blockIndex, BlockDamageFunc damage, void *userData) {
+    int row = blockIndex / level->cols;
+    int col = blockIndex % level->cols;
+
+    for (int r = row - 1; r <= row + 1; r++) {
+        if (r < 0 || r >= level->rows) continue;
+        for (int c = col - 1; c <= col + 1; c++) {
+            if (c < 0 || c >= level->cols || (r == row && c == col)) continue;
+            int neighbour = r * level->cols + c;
+            if (level->blocks[neighbour].active) damage(userData, neighbour);
+        }
+    }
+}
+
+// Anything within one block spacing of the exploding block. The extra
+// pixel makes blocks exactly one spacing away overlap rather than touch.
+static void BlastRects(const LevelData *level, const ColumnIndex *columns, int blockIndex,
+                       BlockDamageFunc damage, void *userData) {
+    if (columns->bucketCount == 0) return;
+
+    const float reach = BLOCK_SPACING + 1.0f;
+    Rectangle blast = level->blocks[blockIndex].rect;
+    blast.x      -= reach;
+    blast.y      -= reach;
+    blast.width  += reach * 2;
+    blast.height += reach * 2;
+
+    int first = ColumnBucket(columns, blast.x);
+    int last  = ColumnBucket(columns, blast.x + blast.width);
+    for (int b = first; b <= last; b++) {
+        for (int n = ColumnBucketStart(columns, b, blast.y + blast.height);
+             n < columns->offsets[b + 1] && columns->bottoms[n] >= blast.y; n++) {
+            int neighbour = columns->blocks[n];
+            const Block *block = &level->blocks[neighbour];
+            if (neighbour == blockIndex || !block->active) continue;
+            if (!CheckCollisionRecs(blast, block->rect)) continue;
+
+            // Blocks spanning several buckets are listed in each; damage once
+            float start = (block->rect.x > blast.x) ? block->rect.x : blast.x;
+            if (ColumnBucket(columns, start) != b) continue;
+            damage(userData, neighbour);
+        }
+    }
+}
+
+int StepChainReaction(ChainReaction *chain, const LevelData *level, const ColumnIndex *columns,
+                      int budget, BlockDamageFunc damage, void *userData) {
+    bool grid = IsGridLevel(level);
+    int exploded = 0;
+
+    // Blocks ignited during this step join the back of the queue and wait
+    // for a later tick once the budget is used up
+    while (exploded < budget && chain->queued > 0) {
+        int blockIndex = chain->queue[chain->head];
+        chain->head = (chain->head + 1) % chain->blockCount;
+        chain->queued--;
+        chain->ignited[blockIndex] = 0;
+        if (grid) BlastGrid(level, blockIndex, damage, userData);
+        else      BlastRects(level, columns, blockIndex, damage, userData);
+        exploded++;
+    }
+    return exploded;
+}
@@ -0,0 +1,45 @@
+#ifndef CHAIN_REACTION_H
+#define CHAIN_REACTION_H
+
+#include <stdbool.h>
+#include "level.h"
+#include "column_index.h"
+
+#define CHAIN_REACTION_BUDGET 32     // explosions per tick in game
+
+// Applies one blast's worth of damage; igniting further explosives is up to it.
+typedef void (*BlockDamageFunc)(void *userData, int blockIndex);
+
+// ----------------------------------------------------------------------
+//  Breadth-first wave of explosions over a level
+//
+//  Destroyed explosive blocks are queued, and each tick pops at most a
+//  budget's worth and damages their neighbours. A block is in the queue at
+//  most once at a time, so a ring of block count entries never overflows,
+//  and a screen-wide chain spreads over several ticks instead of landing
+//  in one. Once a block has gone off it can be ignited again, should it
+//  come back.
+// ----------------------------------------------------------------------
+typedef struct ChainReaction {
+    int *queue;
+    int head;                // next to explode
+    int tail;                // next free slot
+    int queued;
+    unsigned char *ignited;  // per block, set while queued
+    int blockCount;
+} ChainReaction;
+
+bool InitChainReaction(ChainReaction *chain, int blockCount);
+void FreeChainReaction(ChainReaction *chain);
+
+void IgniteBlock(ChainReaction *chain, int blockIndex);
+void ClearChainReaction(ChainReaction *chain);      // drops everything queued
+bool IsChainReactionActive(const ChainReaction *chain);
+
+// Explodes up to budget queued blocks. Neighbours on a standard grid are
+// the eight surrounding cells; custom-rect levels use whatever touches the
+// block, found through columns. Returns how many exploded.
+int StepChainReaction(ChainReaction *chain, const LevelData *level, const ColumnIndex *columns,
+                      int budget, BlockDamageFunc damage, void *userData);
+
+#endif // CHAIN_REACTION_H
@@ -0,0 +1,32 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// CRC-32 (IEEE 802.3). Pass 0 as the seed for a fresh checksum, or a
+// previous result to continue over split buffers.
+uint32_t Crc32(uint32_t seed, const void *data, size_t size);
+
+// ----------------------------------------------------------------------
+//  xxHash32, for hashing the world every tick
+//
+//  Several times faster than Crc32 and a far better mix, so any changed
+//  bit shows. Words are read little-endian on every CPU, so the same bytes
+//  hash the same everywhere. Feed it in pieces of any size; the result is
+//  the same as one call over the whole buffer.
+// ----------------------------------------------------------------------
+typedef struct HashState {
+    uint32_t lanes[4];
+    uint32_t seed;
+    uint32_t totalSize;          // bytes fed so far, modulo 2^32 as xxHash32 has it
+    uint32_t pendingSize;
+    unsigned char pending[16];   // tail shorter than a stripe
+} HashState;
+
+void BeginHash(HashState *hash, uint32_t seed);
+void UpdateHash(HashState *hash, const void *data, size_t size);
+uint32_t FinishHash(const HashState *hash);
+uint32_t Hash32(uint32_t seed, const void *data, size_t size);
+
+#endif // CHECKSUM_H
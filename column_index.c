@@ -0,0 +1,144 @@
+#include "column_index.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Bucket span of a block, clamped to the index
+static void BlockBuckets(const ColumnIndex *index, Rectangle rect, int *first, int *last) {
+    *first = ColumnBucket(index, rect.x);
+    *last  = ColumnBucket(index, rect.x + rect.width);
+}
+
+// Sort key travels with the block so the comparator needs no context
+typedef struct ColumnEntry {
+    float bottom;
+    int block;
+} ColumnEntry;
+
+static int CompareBottomDescending(const void *a, const void *b) {
+    float bottomA = ((const ColumnEntry *)a)->bottom;
+    float bottomB = ((const ColumnEntry *)b)->bottom;
+    return (bottomA < bottomB) - (bottomA > bottomB);
+}
+
+// ----------------------------------------------------------------------
+//  Two passes: count per bucket, then fill, then order each bucket from
+//  the bottom of the screen up
+// ----------------------------------------------------------------------
+bool BuildColumnIndex(ColumnIndex *index, const LevelData *level) {
+    memset(index, 0, sizeof(*index));
+    if (level->blockCount == 0) return true;
+
+    const Block *blocks = level->blocks;
+    float minX = blocks[0].rect.x;
+    float maxX = blocks[0].rect.x + blocks[0].rect.width;
+    for (int i = 1; i < level->blockCount; i++) {
+        if (blocks[i].rect.x < minX) minX = blocks[i].rect.x;
+        if (blocks[i].rect.x + blocks[i].rect.width > maxX) maxX = blocks[i].rect.x + blocks[i].rect.width;
+    }
+    for (int i = 0; i < level->blockCount; i++) {
+        if (blocks[i].rect.height > index->maxHeight) index->maxHeight = blocks[i].rect.height;
+    }
+
+    // Grid levels land exactly one column per bucket
+    index->originX     = minX;
+    index->bucketWidth = BLOCK_WIDTH + BLOCK_SPACING;
+    index->bucketCount = (int)((maxX - minX) / index->bucketWidth) + 1;
+
+    int *counts = calloc(index->bucketCount, sizeof(int));
+    index->offsets = malloc(sizeof(int) * (index->bucketCount + 1));
+    if (!counts || !index->offsets) {
+        free(counts);
+        FreeColumnIndex(index);
+        return false;
+    }
+
+    for (int i = 0; i < level->blockCount; i++) {
+        int first, last;
+        BlockBuckets(index, blocks[i].rect, &first, &last);
+        for (int b = first; b <= last; b++) counts[b]++;
+    }
+
+    index->offsets[0] = 0;
+    for (int b = 0; b < index->bucketCount; b++) index->offsets[b + 1] = index->offsets[b] + counts[b];
+
+    int total = index->offsets[index->bucketCount];
+    ColumnEntry *entries = malloc(sizeof(ColumnEntry) * total);
+    index->blocks  = malloc(sizeof(int) * total);
+    index->bottoms = malloc(sizeof(float) * total);
+    if (!entries || !index->blocks || !index->bottoms) {
+        free(counts);
+        free(entries);
+        FreeColumnIndex(index);
+        return false;
+    }
+
+    memset(counts, 0, sizeof(int) * index->bucketCount);
+    for (int i = 0; i < level->blockCount; i++) {
+        int first, last;
+        BlockBuckets(index, blocks[i].rect, &first, &last);
+        for (int b = first; b <= last; b++) {
+            ColumnEntry *entry = &entries[index->offsets[b] + counts[b]++];
+            entry->bottom = blocks[i].rect.y + blocks[i].rect.height;
+            entry->block  = i;
+        }
+    }
+    free(counts);
+
+    for (int b = 0; b < index->bucketCount; b++) {
+        qsort(entries + index->offsets[b], index->offsets[b + 1] - index->offsets[b],
+              sizeof(ColumnEntry), CompareBottomDescending);
+    }
+    for (int n = 0; n < total; n++) {
+        index->blocks[n]  = entries[n].block;
+        index->bottoms[n] = entries[n].bottom;
+    }
+    free(entries);
+    return true;
+}
+
+int ColumnBucket(const ColumnIndex *index, float x) {
+    int bucket = (int)floorf((x - index->originX) / index->bucketWidth);
+    if (bucket < 0) return 0;
+    if (bucket >= index->bucketCount) return index->bucketCount - 1;
+    return bucket;
+}
+
+int ColumnBucketStart(const ColumnIndex *index, int bucket, float y) {
+    // A block whose bottom is more than maxHeight below y has its top below y too
+    float limit = y + index->maxHeight;
+    int low  = index->offsets[bucket];
+    int high = index->offsets[bucket + 1];
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (index->bottoms[mid] > limit) low = mid + 1;
+        else                             high = mid;
+    }
+    return low;
+}
+
+void FreeColumnIndex(ColumnIndex *index) {
+    free(index->offsets);
+    free(index->blocks);
+    free(index->bottoms);
+    memset(index, 0, sizeof(*index));
+}
+
+int FindColumnHit(const ColumnIndex *index, const Block *blocks, float x, float yFrom, float yTo) {
+    if (index->bucketCount == 0) return -1;
+
+    int bucket = (int)floorf((x - index->originX) / index->bucketWidth);
+    if (bucket < 0 || bucket >= index->bucketCount) return -1;
+
+    for (int n = ColumnBucketStart(index, bucket, yFrom); n < index->offsets[bucket + 1]; n++) {
+        if (index->bottoms[n] < yTo) break;             // this and everything after is above the sweep
+
+        const Block *block = &blocks[index->blocks[n]];
+        Rectangle rect = block->rect;
+        if (!block->active || rect.y > yFrom) continue; // gone, or still below the shot
+        if (x < rect.x || x > rect.x + rect.width) continue;
+        return index->blocks[n];
+    }
+    return -1;
+}
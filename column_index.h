@@ -0,0 +1,40 @@
+#ifndef COLUMN_INDEX_H
+#define COLUMN_INDEX_H
+
+#include <stdbool.h>
+#include "level.h"
+
+// ----------------------------------------------------------------------
+//  Blocks bucketed by screen column, for anything that travels straight
+//  up or down. Each bucket lists the blocks overlapping it, lowest on
+//  screen first, so a vertical sweep stops at the first live block
+//  instead of scanning the level, and a y range inside a bucket is found
+//  by binary search.
+// ----------------------------------------------------------------------
+typedef struct ColumnIndex {
+    float originX;
+    float bucketWidth;
+    int bucketCount;
+    int *offsets;            // bucketCount + 1 entries into blocks
+    int *blocks;             // block indices, bucket by bucket
+    float *bottoms;          // bottom edge of each entry in blocks, descending per bucket
+    float maxHeight;         // tallest block, bounds how far above a bottom a block reaches
+} ColumnIndex;
+
+// Built once per level; block positions never change during a round.
+bool BuildColumnIndex(ColumnIndex *index, const LevelData *level);
+void FreeColumnIndex(ColumnIndex *index);
+
+// Bucket holding x, clamped to the index
+int ColumnBucket(const ColumnIndex *index, float x);
+
+// First entry of bucket that may overlap anything at or above y, i.e. skips
+// the blocks lying wholly below it. Walk forward while bottoms[n] >= the top
+// of the range of interest.
+int ColumnBucketStart(const ColumnIndex *index, int bucket, float y);
+
+// First active block hit by a point moving from yFrom up to yTo (yTo < yFrom)
+// at x, or -1.
+int FindColumnHit(const ColumnIndex *index, const Block *blocks, float x, float yFrom, float yTo);
+
+#endif // COLUMN_INDEX_H
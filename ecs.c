@@ -0,0 +1,261 @@
+#include "ecs.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define ECS_ALIGN 16
+
+static const size_t componentSizes[ECS_COMPONENT_COUNT] = {
+    [COMP_POSITION] = sizeof(Vector2),
+    [COMP_VELOCITY] = sizeof(Vector2),
+    [COMP_COLLIDER] = sizeof(ColliderComponent),
+    [COMP_BALL]     = sizeof(BallComponent),
+    [COMP_PADDLE]   = sizeof(PaddleComponent),
+    [COMP_PICKUP]   = sizeof(PickupComponent),
+};
+
+static size_t AlignUp(size_t value) {
+    return (value + ECS_ALIGN - 1) & ~(size_t)(ECS_ALIGN - 1);
+}
+
+static uint32_t EntityIndex(EcsEntity entity)      { return entity & 0xFFFFu; }
+static uint16_t EntityGeneration(EcsEntity entity) { return (uint16_t)(entity >> 16); }
+
+static EcsEntity MakeEntity(uint32_t index, uint16_t generation) {
+    return ((EcsEntity)generation << 16) | index;
+}
+
+// Bytes one chunk of this archetype needs: entity ids plus one aligned column per component
+static size_t ChunkBytes(uint32_t mask) {
+    size_t bytes = AlignUp(sizeof(EcsEntity) * ECS_CHUNK_CAPACITY);
+    for (int c = 0; c < ECS_COMPONENT_COUNT; c++) {
+        if (mask & ECS_MASK(c)) bytes += AlignUp(componentSizes[c] * ECS_CHUNK_CAPACITY);
+    }
+    return bytes;
+}
+
+bool InitEcsWorld(EcsWorld *world, size_t arenaBytes) {
+    memset(world, 0, sizeof(*world));
+
+    if (arenaBytes == 0) {
+        // Enough for every entity in the widest archetype, plus one partly
+        // filled chunk per archetype
+        arenaBytes = ChunkBytes((1u << ECS_COMPONENT_COUNT) - 1)
+                   * (ECS_MAX_CHUNKS + ECS_MAX_ARCHETYPES);
+    }
+    world->arena = malloc(AlignUp(arenaBytes));
+    if (!world->arena) return false;
+    world->arenaSize = AlignUp(arenaBytes);
+
+    ClearEcsWorld(world);
+    return true;
+}
+
+void FreeEcsWorld(EcsWorld *world) {
+    free(world->arena);
+    memset(world, 0, sizeof(*world));
+}
+
+void ClearEcsWorld(EcsWorld *world) {
+    // Archetypes and their chunks stay allocated; only the rows are dropped
+    for (int a = 0; a < world->archetypeCount; a++) {
+        world->archetypes[a].entityCount = 0;
+    }
+
+    // Hand out low slots first; slot 0 is reserved for ECS_INVALID_ENTITY
+    world->freeCount = 0;
+    for (uint32_t i = ECS_MAX_ENTITIES - 1; i > 0; i--) {
+        world->freeSlots[world->freeCount++] = i;
+        world->locations[i].archetype = -1;
+        world->locations[i].generation++;
+    }
+    world->locations[0].archetype = -1;
+    world->pendingCount = 0;
+}
+
+// ----------------------------------------------------------------------
+//  Archetype and chunk lookup
+// ----------------------------------------------------------------------
+static int FindArchetype(EcsWorld *world, uint32_t mask) {
+    for (int a = 0; a < world->archetypeCount; a++) {
+        if (world->archetypes[a].mask == mask) return a;
+    }
+    if (world->archetypeCount >= ECS_MAX_ARCHETYPES) return -1;
+
+    EcsArchetype *archetype = &world->archetypes[world->archetypeCount];
+    memset(archetype, 0, sizeof(*archetype));
+    archetype->mask = mask;
+    return world->archetypeCount++;
+}
+
+static bool ReserveChunk(EcsWorld *world, EcsArchetype *archetype) {
+    if (archetype->chunkCount >= ECS_MAX_CHUNKS) return false;
+
+    size_t bytes = ChunkBytes(archetype->mask);
+    if (world->arenaUsed + bytes > world->arenaSize) return false;
+
+    unsigned char *memory = world->arena + world->arenaUsed;
+    world->arenaUsed += bytes;
+
+    EcsChunk *chunk = &archetype->chunks[archetype->chunkCount++];
+    chunk->entities = (EcsEntity *)memory;
+    memory += AlignUp(sizeof(EcsEntity) * ECS_CHUNK_CAPACITY);
+    for (int c = 0; c < ECS_COMPONENT_COUNT; c++) {
+        if (archetype->mask & ECS_MASK(c)) {
+            chunk->columns[c] = memory;
+            memory += AlignUp(componentSizes[c] * ECS_CHUNK_CAPACITY);
+        } else {
+            chunk->columns[c] = NULL;
+        }
+    }
+    return true;
+}
+
+static void *RowComponent(EcsArchetype *archetype, int row, ComponentId component) {
+    EcsChunk *chunk = &archetype->chunks[row / ECS_CHUNK_CAPACITY];
+    unsigned char *column = chunk->columns[component];
+    if (!column) return NULL;
+    return column + componentSizes[component] * (row % ECS_CHUNK_CAPACITY);
+}
+
+static EcsEntity *RowEntity(EcsArchetype *archetype, int row) {
+    return &archetype->chunks[row / ECS_CHUNK_CAPACITY].entities[row % ECS_CHUNK_CAPACITY];
+}
+
+// ----------------------------------------------------------------------
+//  Entities
+// ----------------------------------------------------------------------
+EcsEntity CreateEntity(EcsWorld *world, uint32_t mask) {
+    if (world->freeCount == 0) return ECS_INVALID_ENTITY;
+
+    int archetypeIndex = FindArchetype(world, mask);
+    if (archetypeIndex < 0) return ECS_INVALID_ENTITY;
+
+    EcsArchetype *archetype = &world->archetypes[archetypeIndex];
+    int row = archetype->entityCount;
+    if (row / ECS_CHUNK_CAPACITY >= archetype->chunkCount && !ReserveChunk(world, archetype)) {
+        return ECS_INVALID_ENTITY;
+    }
+
+    uint32_t index = world->freeSlots[--world->freeCount];
+    EcsLocation *location = &world->locations[index];
+    location->archetype = (int16_t)archetypeIndex;
+    location->row       = (uint16_t)row;
+
+    EcsEntity entity = MakeEntity(index, location->generation);
+    *RowEntity(archetype, row) = entity;
+    for (int c = 0; c < ECS_COMPONENT_COUNT; c++) {
+        if (mask & ECS_MASK(c)) memset(RowComponent(archetype, row, c), 0, componentSizes[c]);
+    }
+
+    archetype->entityCount++;
+    return entity;
+}
+
+bool IsEntityAlive(const EcsWorld *world, EcsEntity entity) {
+    uint32_t index = EntityIndex(entity);
+    if (index == 0 || index >= ECS_MAX_ENTITIES) return false;
+
+    const EcsLocation *location = &world->locations[index];
+    return location->archetype >= 0 && location->generation == EntityGeneration(entity);
+}
+
+void DestroyEntity(EcsWorld *world, EcsEntity entity) {
+    if (!IsEntityAlive(world, entity)) return;
+
+    uint32_t index = EntityIndex(entity);
+    EcsLocation *location = &world->locations[index];
+    EcsArchetype *archetype = &world->archetypes[location->archetype];
+
+    // Keep rows dense: the archetype's last row moves into the hole
+    int row  = location->row;
+    int last = archetype->entityCount - 1;
+    if (row != last) {
+        EcsEntity moved = *RowEntity(archetype, last);
+        *RowEntity(archetype, row) = moved;
+        for (int c = 0; c < ECS_COMPONENT_COUNT; c++) {
+            if (archetype->mask & ECS_MASK(c)) {
+                memcpy(RowComponent(archetype, row, c), RowComponent(archetype, last, c), componentSizes[c]);
+            }
+        }
+        world->locations[EntityIndex(moved)].row = (uint16_t)row;
+    }
+    archetype->entityCount--;
+
+    location->archetype = -1;
+    location->generation++;
+    world->freeSlots[world->freeCount++] = index;
+}
+
+void *GetComponent(EcsWorld *world, EcsEntity entity, ComponentId component) {
+    if (!IsEntityAlive(world, entity)) return NULL;
+
+    const EcsLocation *location = &world->locations[EntityIndex(entity)];
+    return RowComponent(&world->archetypes[location->archetype], location->row, component);
+}
+
+// Duplicates are harmless: the second DestroyEntity sees a stale generation
+void DeferDestroyEntity(EcsWorld *world, EcsEntity entity) {
+    if (world->pendingCount < ECS_MAX_ENTITIES) {
+        world->pendingDestroy[world->pendingCount++] = entity;
+    }
+}
+
+void FlushDestroyedEntities(EcsWorld *world) {
+    for (int i = 0; i < world->pendingCount; i++) {
+        DestroyEntity(world, world->pendingDestroy[i]);
+    }
+    world->pendingCount = 0;
+}
+
+// ----------------------------------------------------------------------
+//  Queries
+// ----------------------------------------------------------------------
+EcsIter QueryEntities(EcsWorld *world, uint32_t mask) {
+    EcsIter iter = { 0 };
+    iter.world     = world;
+    iter.mask      = mask;
+    iter.archetype = 0;
+    iter.chunk     = -1;
+    return iter;
+}
+
+bool NextChunk(EcsIter *iter) {
+    EcsWorld *world = iter->world;
+
+    while (iter->archetype < world->archetypeCount) {
+        EcsArchetype *archetype = &world->archetypes[iter->archetype];
+        if ((archetype->mask & iter->mask) == iter->mask) {
+            int next = iter->chunk + 1;
+            int remaining = archetype->entityCount - next * ECS_CHUNK_CAPACITY;
+            if (remaining > 0) {
+                iter->chunk   = next;
+                iter->count   = remaining < ECS_CHUNK_CAPACITY ? remaining : ECS_CHUNK_CAPACITY;
+                iter->current = &archetype->chunks[next];
+                return true;
+            }
+        }
+        iter->archetype++;
+        iter->chunk = -1;
+    }
+
+    iter->count   = 0;
+    iter->current = NULL;
+    return false;
+}
+
+void *IterColumn(const EcsIter *iter, ComponentId component) {
+    return iter->current ? iter->current->columns[component] : NULL;
+}
+
+const EcsEntity *IterEntities(const EcsIter *iter) {
+    return iter->current ? iter->current->entities : NULL;
+}
+
+int CountEntities(EcsWorld *world, uint32_t mask) {
+    int count = 0;
+    for (int a = 0; a < world->archetypeCount; a++) {
+        if ((world->archetypes[a].mask & mask) == mask) count += world->archetypes[a].entityCount;
+    }
+    return count;
+}
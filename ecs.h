@@ -0,0 +1,138 @@
+#ifndef ECS_H
+#define ECS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "raylib.h"
+
+#define ECS_MAX_ENTITIES      4096
+#define ECS_MAX_ARCHETYPES    16
+#define ECS_CHUNK_CAPACITY    128      // entities per chunk
+#define ECS_MAX_CHUNKS        (ECS_MAX_ENTITIES / ECS_CHUNK_CAPACITY)
+#define ECS_INVALID_ENTITY    0u
+
+// ----------------------------------------------------------------------
+//  Components
+// ----------------------------------------------------------------------
+typedef enum {
+    COMP_POSITION,           // Vector2, centre for balls, top-left for rect shapes
+    COMP_VELOCITY,           // Vector2, pixels per second
+    COMP_COLLIDER,           // circle that can touch the paddle
+    COMP_BALL,
+    COMP_PADDLE,
+    COMP_PICKUP,
+    ECS_COMPONENT_COUNT
+} ComponentId;
+
+#define ECS_MASK(component) (1u << (component))
+
+typedef enum {
+    POWERUP_MULTIBALL,
+    POWERUP_WIDE_PADDLE,
+    POWERUP_SLOW_BALL,
+    POWERUP_LASER,
+    POWERUP_KIND_COUNT
+} PowerUpKind;
+
+typedef struct ColliderComponent {
+    float radius;
+} ColliderComponent;
+
+typedef struct BallComponent {
+    Color color;
+    bool isMain;             // the ball the player launches; losing it costs a life
+} BallComponent;
+
+typedef struct PaddleComponent {
+    Vector2 size;
+    float speed;
+} PaddleComponent;
+
+typedef struct PickupComponent {
+    PowerUpKind kind;
+} PickupComponent;
+
+// Slot index in the low 16 bits, generation in the high 16, so a handle to
+// a destroyed entity never resolves to whatever reused its slot.
+// Index 0 is never handed out, which keeps ECS_INVALID_ENTITY free.
+typedef uint32_t EcsEntity;
+
+// Slot of a live entity, for side tables indexed per entity
+#define ECS_ENTITY_SLOT(entity) ((int)((entity) & 0xFFFFu))
+
+// ----------------------------------------------------------------------
+//  Archetype storage
+//
+//  Every distinct component mask gets an archetype. Its entities are packed
+//  into fixed-size chunks, and inside a chunk each component is its own
+//  dense array, so a system walks plain arrays and never sees entities
+//  lacking its components. Chunk memory comes from one arena allocated up
+//  front: creating and destroying entities never touches the heap.
+// ----------------------------------------------------------------------
+typedef struct EcsChunk {
+    EcsEntity *entities;
+    void *columns[ECS_COMPONENT_COUNT];     // NULL for components not in the archetype
+} EcsChunk;
+
+typedef struct EcsArchetype {
+    uint32_t mask;
+    int entityCount;                        // rows [0, entityCount) are live, chunk by chunk
+    int chunkCount;                         // chunks allocated so far
+    EcsChunk chunks[ECS_MAX_CHUNKS];
+} EcsArchetype;
+
+typedef struct EcsLocation {
+    uint16_t generation;
+    int16_t archetype;                      // -1 when the slot is free
+    uint16_t row;                           // row within the archetype
+} EcsLocation;
+
+typedef struct EcsWorld {
+    EcsArchetype archetypes[ECS_MAX_ARCHETYPES];
+    int archetypeCount;
+
+    EcsLocation locations[ECS_MAX_ENTITIES];
+    uint32_t freeSlots[ECS_MAX_ENTITIES];
+    int freeCount;
+
+    EcsEntity pendingDestroy[ECS_MAX_ENTITIES];
+    int pendingCount;
+
+    unsigned char *arena;
+    size_t arenaSize;
+    size_t arenaUsed;
+} EcsWorld;
+
+// Walks the chunks of every archetype that has all components in mask
+typedef struct EcsIter {
+    EcsWorld *world;
+    uint32_t mask;
+    int archetype;
+    int chunk;
+    int count;                              // live entities in the current chunk
+    EcsChunk *current;
+} EcsIter;
+
+bool InitEcsWorld(EcsWorld *world, size_t arenaBytes);
+void FreeEcsWorld(EcsWorld *world);
+void ClearEcsWorld(EcsWorld *world);        // drops all entities, keeps the memory
+
+// Components start zeroed. Returns ECS_INVALID_ENTITY when full.
+EcsEntity CreateEntity(EcsWorld *world, uint32_t mask);
+void DestroyEntity(EcsWorld *world, EcsEntity entity);
+bool IsEntityAlive(const EcsWorld *world, EcsEntity entity);
+void *GetComponent(EcsWorld *world, EcsEntity entity, ComponentId component);
+
+// Systems must not destroy while iterating; defer and flush afterwards.
+void DeferDestroyEntity(EcsWorld *world, EcsEntity entity);
+void FlushDestroyedEntities(EcsWorld *world);
+
+EcsIter QueryEntities(EcsWorld *world, uint32_t mask);
+bool NextChunk(EcsIter *iter);
+void *IterColumn(const EcsIter *iter, ComponentId component);
+const EcsEntity *IterEntities(const EcsIter *iter);
+
+int CountEntities(EcsWorld *world, uint32_t mask);
+
+#endif // ECS_H
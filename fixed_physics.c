@@ -0,0 +1,137 @@
+#include "fixed_physics.h"
+
+#include <math.h>
+
+// sin of 0..90 degrees in 16.16
+static const int32_t SINE_TABLE[91] = {
+    0, 1144, 2287, 3430, 4572, 5712, 6850, 7987, 9121, 10252,
+    11380, 12505, 13626, 14742, 15855, 16962, 18064, 19161, 20252, 21336,
+    22415, 23486, 24550, 25607, 26656, 27697, 28729, 29753, 30767, 31772,
+    32768, 33754, 34729, 35693, 36647, 37590, 38521, 39441, 40348, 41243,
+    42126, 42995, 43852, 44695, 45525, 46341, 47143, 47930, 48703, 49461,
+    50203, 50931, 51643, 52339, 53020, 53684, 54332, 54963, 55578, 56175,
+    56756, 57319, 57865, 58393, 58903, 59396, 59870, 60326, 60764, 61183,
+    61584, 61966, 62328, 62672, 62997, 63303, 63589, 63856, 64104, 64332,
+    64540, 64729, 64898, 65048, 65177, 65287, 65376, 65446, 65496, 65526,
+    65536,
+};
+
+Fixed ToFixed(float value) {
+    float scaled = value * (float)FIXED_ONE;    // a power of two, exact
+    return (Fixed)(scaled + copysignf(0.5f, scaled));
+}
+
+float FromFixed(Fixed value) {
+    return (float)value * (1.0f / FIXED_ONE);
+}
+
+int32_t ToFixedTime(float seconds) {
+    return (int32_t)(seconds * (float)FIXED_TIME_ONE + 0.5f);
+}
+
+// speed * step in 24.8, rounded
+static Fixed Travel(Fixed speed, int32_t step) {
+    return (Fixed)(((int64_t)speed * step + (FIXED_TIME_ONE / 2)) >> FIXED_TIME_SHIFT);
+}
+
+// ----------------------------------------------------------------------
+//  Movement
+// ----------------------------------------------------------------------
+bool FixedMoveBall(Vector2 *position, Vector2 *velocity, float radius, float width, float height, int32_t step) {
+    Fixed x  = ToFixed(position->x), y  = ToFixed(position->y);
+    Fixed vx = ToFixed(velocity->x), vy = ToFixed(velocity->y);
+    Fixed r  = ToFixed(radius);
+
+    x += Travel(vx, step);
+    y += Travel(vy, step);
+
+    if ((x - r <= 0 && vx < 0) || (x + r >= ToFixed(width) && vx > 0)) vx = -vx;
+    if (y - r <= 0 && vy < 0) vy = -vy;
+
+    *position = (Vector2){ FromFixed(x), FromFixed(y) };
+    *velocity = (Vector2){ FromFixed(vx), FromFixed(vy) };
+    return y + r >= ToFixed(height);
+}
+
+float FixedAdvance(float value, float speed, int32_t step) {
+    return FromFixed(ToFixed(value) + Travel(ToFixed(speed), step));
+}
+
+// ----------------------------------------------------------------------
+//  Contacts, in doubled units so half widths stay whole
+// ----------------------------------------------------------------------
+#define REJECT_MARGIN 2     // pixels, more than raylib's centre truncation can move
+
+FixedCircle ToFixedCircle(Vector2 centre, float radius) {
+    FixedCircle circle;
+    circle.x      = ToFixed(centre.x);
+    circle.y      = ToFixed(centre.y);
+    circle.radius = ToFixed(radius);
+    circle.left   = FromFixed(circle.x - circle.radius - REJECT_MARGIN * FIXED_ONE);
+    circle.right  = FromFixed(circle.x + circle.radius + REJECT_MARGIN * FIXED_ONE);
+    circle.top    = FromFixed(circle.y - circle.radius - REJECT_MARGIN * FIXED_ONE);
+    circle.bottom = FromFixed(circle.y + circle.radius + REJECT_MARGIN * FIXED_ONE);
+    return circle;
+}
+
+// Doubled distance from the circle to the rect centre along one axis.
+// raylib truncates that centre to a whole pixel.
+static int64_t AxisDistance(Fixed circle, Fixed start, Fixed size2) {
+    int64_t doubled = 2 * (int64_t)start + size2;
+    int64_t centre  = doubled / (2 * FIXED_ONE) * FIXED_ONE;
+    int64_t d = 2 * ((int64_t)circle - centre);
+    return (d < 0) ? -d : d;
+}
+
+bool FixedCircleTouchesRect(FixedCircle circle, Rectangle rect) {
+    // Most rects a ball is tested against are nowhere near it. A single
+    // float add is correctly rounded everywhere and the margin dwarfs its
+    // error, so this never turns away a rect the exact test below accepts.
+    if (rect.x > circle.right || rect.x + rect.width < circle.left ||
+        rect.y > circle.bottom || rect.y + rect.height < circle.top) return false;
+
+    int64_t r2 = 2 * (int64_t)circle.radius;
+    int64_t w2 = ToFixed(rect.width);
+    int64_t dx = AxisDistance(circle.x, ToFixed(rect.x), (Fixed)w2);
+    if (dx > w2 + r2) return false;
+
+    int64_t h2 = ToFixed(rect.height);
+    int64_t dy = AxisDistance(circle.y, ToFixed(rect.y), (Fixed)h2);
+    if (dy > h2 + r2) return false;
+    if (dx <= w2 || dy <= h2) return true;
+
+    int64_t cornerX = dx - w2;
+    int64_t cornerY = dy - h2;
+    return cornerX * cornerX + cornerY * cornerY <= r2 * r2;
+}
+
+void FixedPaddleBounce(Vector2 position, Vector2 *velocity, Rectangle paddle, float ballSpeed) {
+    Fixed speed = ToFixed(ballSpeed);
+    Fixed width = ToFixed(paddle.width);
+    if (width <= 0) width = 1;
+
+    // (hitPos - 0.5) * 2 * speed, hitPos = offset / width
+    int64_t offset = (int64_t)ToFixed(position.x) - ToFixed(paddle.x);
+    Fixed vx = (Fixed)(offset * 2 * speed / width) - speed;
+
+    *velocity = (Vector2){ FromFixed(vx), FromFixed(-speed) };
+}
+
+// ----------------------------------------------------------------------
+//  Angles
+// ----------------------------------------------------------------------
+static int32_t FixedSine(int degrees) {
+    degrees %= 360;
+    if (degrees < 0) degrees += 360;
+    if (degrees <= 90)  return SINE_TABLE[degrees];
+    if (degrees <= 180) return SINE_TABLE[180 - degrees];
+    if (degrees <= 270) return -SINE_TABLE[degrees - 180];
+    return -SINE_TABLE[360 - degrees];
+}
+
+Vector2 FixedAngleVelocity(int degrees, float ballSpeed) {
+    int64_t speed = ToFixed(ballSpeed);
+    Fixed vx = (Fixed)((speed * FixedSine(degrees + 90) + (FIXED_TIME_ONE / 2)) >> FIXED_TIME_SHIFT);
+    Fixed vy = (Fixed)((speed * FixedSine(degrees) + (FIXED_TIME_ONE / 2)) >> FIXED_TIME_SHIFT);
+    return (Vector2){ FromFixed(vx), FromFixed(vy) };
+}
@@ -0,0 +1,65 @@
+#ifndef FIXED_PHYSICS_H
+#define FIXED_PHYSICS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "raylib.h"
+
+#define FIXED_SHIFT      8                      // positions and speeds: 24.8
+#define FIXED_ONE        (1 << FIXED_SHIFT)
+#define FIXED_TIME_SHIFT 16                     // seconds and scales: 16.16
+#define FIXED_TIME_ONE   (1 << FIXED_TIME_SHIFT)
+
+typedef int32_t Fixed;
+
+// A ball converted once for testing against many rects. The float bounds
+// are its box widened by two pixels, only used to skip rects early.
+typedef struct FixedCircle {
+    Fixed x, y;
+    Fixed radius;
+    float left, right, top, bottom;
+} FixedCircle;
+
+// ----------------------------------------------------------------------
+//  Integer ball, paddle, pickup and laser physics for replays and lockstep
+//  across CPUs
+//
+//  State stays in the usual float Vector2 components, but only ever holds
+//  multiples of 1/256 below 65536 in size, which a float represents
+//  exactly. Each step loads it into integers, does all of its arithmetic
+//  there and stores it back, so no result depends on how a compiler
+//  rounds, contracts or vectorises float math, or on libm. The rules are
+//  the float ones from main.c, including raylib's whole-pixel rect centre
+//  in the circle test. Laser shots move with FixedAdvance too, since what
+//  they hit feeds the score, chains and pickups. Particles stay float;
+//  nothing reads them back.
+//
+//  Right shifts of negative values are assumed arithmetic, which holds for
+//  every compiler the game builds with.
+// ----------------------------------------------------------------------
+
+// Nearest 1/256, halves away from zero. Pure float multiply and truncate,
+// so the same input gives the same result everywhere.
+Fixed ToFixed(float value);
+float FromFixed(Fixed value);                   // exact
+int32_t ToFixedTime(float seconds);             // nearest 1/65536
+
+// Moves a ball by velocity * step (16.16 seconds), then reverses it off the
+// side walls and ceiling while it heads into them. Returns true once it
+// touches the bottom.
+bool FixedMoveBall(Vector2 *position, Vector2 *velocity, float radius, float width, float height, int32_t step);
+
+// value + speed * step, e.g. the paddle or a falling pickup
+float FixedAdvance(float value, float speed, int32_t step);
+
+// Same test as raylib's CheckCollisionCircleRec
+FixedCircle ToFixedCircle(Vector2 centre, float radius);
+bool FixedCircleTouchesRect(FixedCircle circle, Rectangle rect);
+
+// Straight up at ballSpeed, sideways by where the ball met the paddle
+void FixedPaddleBounce(Vector2 position, Vector2 *velocity, Rectangle paddle, float ballSpeed);
+
+// ballSpeed along a whole-degree angle, from a table rather than sinf/cosf
+Vector2 FixedAngleVelocity(int degrees, float ballSpeed);
+
+#endif // FIXED_PHYSICS_H
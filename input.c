@@ -0,0 +1,206 @@
+#include "input.h"
+
+#include <string.h>
+#include "raylib.h"
+
+#define INPUT_FILE_MAGIC   "BKIN"
+#define INPUT_FILE_VERSION 2         // 2: world state hash after every frame
+
+static const int actionKeys[ACTION_COUNT][INPUT_KEYS_PER_ACTION] = {
+    [ACTION_MENU_UP]    = { KEY_UP,    KEY_W },
+    [ACTION_MENU_DOWN]  = { KEY_DOWN,  KEY_S },
+    [ACTION_CONFIRM]    = { KEY_ENTER, KEY_SPACE },
+    [ACTION_LAUNCH]     = { KEY_SPACE, KEY_NULL },
+    [ACTION_MOVE_LEFT]  = { KEY_A,     KEY_NULL },
+    [ACTION_MOVE_RIGHT] = { KEY_D,     KEY_NULL },
+    [ACTION_YES]        = { KEY_Y,     KEY_NULL },
+    [ACTION_NO]         = { KEY_N,     KEY_NULL },
+    [ACTION_FIRE]       = { KEY_SPACE, KEY_LEFT_CONTROL },
+    [ACTION_QUICK_SAVE] = { KEY_F5,    KEY_NULL },
+    [ACTION_QUICK_LOAD] = { KEY_F9,    KEY_NULL },
+};
+
+static uint32_t   keyActions[INPUT_KEY_CODES];
+static InputFrame frame;
+static FILE      *recordFile = NULL;
+static FILE      *replayFile = NULL;
+static uint32_t   replayVersion = 0;
+static uint32_t   replayHash;           // recorded hash of the frame being replayed
+static bool       replayHashValid = false;
+
+void InitInput(void) {
+    memset(keyActions, 0, sizeof(keyActions));
+    for (int action = 0; action < ACTION_COUNT; action++) {
+        for (int i = 0; i < INPUT_KEYS_PER_ACTION; i++) {
+            int key = actionKeys[action][i];
+            if (key > KEY_NULL && key < INPUT_KEY_CODES) keyActions[key] |= 1u << action;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------
+//  Recorded frame layout: dt, held, event count, char count, keys, chars,
+//  then (version 2) the state hash, written once the frame has run
+// ----------------------------------------------------------------------
+static void WriteFrame(FILE *file, const InputFrame *in) {
+    uint8_t counts[2] = { (uint8_t)in->eventCount, (uint8_t)in->charCount };
+    fwrite(&in->dt, sizeof(in->dt), 1, file);
+    fwrite(&in->held, sizeof(in->held), 1, file);
+    fwrite(counts, sizeof(counts), 1, file);
+    for (int i = 0; i < in->eventCount; i++) fwrite(&in->events[i].key, sizeof(uint16_t), 1, file);
+    for (int i = 0; i < in->charCount; i++)  fwrite(&in->chars[i], sizeof(int32_t), 1, file);
+}
+
+static bool ReadFrame(FILE *file, InputFrame *out) {
+    uint8_t counts[2];
+    if (fread(&out->dt, sizeof(out->dt), 1, file) != 1 ||
+        fread(&out->held, sizeof(out->held), 1, file) != 1 ||
+        fread(counts, sizeof(counts), 1, file) != 1 ||
+        counts[0] > INPUT_MAX_EVENTS || counts[1] > INPUT_MAX_CHARS) {
+        return false;
+    }
+
+    out->eventCount = counts[0];
+    out->charCount  = counts[1];
+    out->pressed    = 0;
+    for (int i = 0; i < out->eventCount; i++) {
+        if (fread(&out->events[i].key, sizeof(uint16_t), 1, file) != 1) return false;
+        out->events[i].actions = (out->events[i].key < INPUT_KEY_CODES) ? keyActions[out->events[i].key] : 0;
+        out->pressed |= out->events[i].actions;
+    }
+    for (int i = 0; i < out->charCount; i++) {
+        if (fread(&out->chars[i], sizeof(int32_t), 1, file) != 1) return false;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------
+//  Per-frame drain: cost is the number of events, not the number of keys
+// ----------------------------------------------------------------------
+void PollInput(void) {
+    if (replayFile) {
+        replayHashValid = false;
+        if (ReadFrame(replayFile, &frame)) {
+            replayHashValid = replayVersion >= 2 && fread(&replayHash, sizeof(replayHash), 1, replayFile) == 1;
+            return;
+        }
+        fclose(replayFile);
+        replayFile = NULL;
+    }
+
+    frame.dt         = GetFrameTime();
+    frame.pressed    = 0;
+    frame.eventCount = 0;
+    frame.charCount  = 0;
+
+    for (int key = GetKeyPressed(); key != 0; key = GetKeyPressed()) {
+        if (frame.eventCount == INPUT_MAX_EVENTS) continue;
+        InputEvent *event = &frame.events[frame.eventCount++];
+        event->key      = (uint16_t)key;
+        event->reserved = 0;
+        event->actions  = (key < INPUT_KEY_CODES) ? keyActions[key] : 0;
+        frame.pressed  |= event->actions;
+    }
+    for (int ch = GetCharPressed(); ch != 0; ch = GetCharPressed()) {
+        if (frame.charCount < INPUT_MAX_CHARS) frame.chars[frame.charCount++] = ch;
+    }
+
+    frame.held = 0;
+    for (int action = 0; action < ACTION_COUNT; action++) {
+        for (int i = 0; i < INPUT_KEYS_PER_ACTION; i++) {
+            int key = actionKeys[action][i];
+            if (key != KEY_NULL && IsKeyDown(key)) frame.held |= 1u << action;
+        }
+    }
+
+    if (recordFile) WriteFrame(recordFile, &frame);
+}
+
+// ----------------------------------------------------------------------
+//  Record / replay
+// ----------------------------------------------------------------------
+//  File header: magic, version, then the seed the session ran with.
+//  Version 1 files (no hashes) still replay.
+static FILE *OpenInputFile(const char *path, const char *mode, uint32_t *seed, uint32_t *version) {
+    FILE *file = fopen(path, mode);
+    if (!file) return NULL;
+
+    char magic[4] = INPUT_FILE_MAGIC;
+    bool ok;
+    if (mode[0] == 'w') {
+        *version = INPUT_FILE_VERSION;
+        ok = fwrite(magic, 4, 1, file) == 1 &&
+             fwrite(version, sizeof(*version), 1, file) == 1 &&
+             fwrite(seed, sizeof(*seed), 1, file) == 1;
+    }
+    else {
+        ok = fread(magic, 4, 1, file) == 1 &&
+             fread(version, sizeof(*version), 1, file) == 1 &&
+             fread(seed, sizeof(*seed), 1, file) == 1 &&
+             memcmp(magic, INPUT_FILE_MAGIC, 4) == 0 &&
+             *version >= 1 && *version <= INPUT_FILE_VERSION;
+    }
+    if (!ok) {
+        fclose(file);
+        return NULL;
+    }
+    return file;
+}
+
+bool StartInputRecording(const char *path, uint32_t seed) {
+    StopInputRecording();
+    uint32_t version;
+    recordFile = OpenInputFile(path, "wb", &seed, &version);
+    return recordFile != NULL;
+}
+
+bool StartInputReplay(const char *path, uint32_t *seed) {
+    if (replayFile) fclose(replayFile);
+    replayFile      = OpenInputFile(path, "rb", seed, &replayVersion);
+    replayHashValid = false;
+    return replayFile != NULL;
+}
+
+void StopInputRecording(void) {
+    if (recordFile) fclose(recordFile);
+    recordFile = NULL;
+}
+
+bool IsInputReplaying(void) {
+    return replayFile != NULL;
+}
+
+void RecordStateHash(uint32_t hash) {
+    if (recordFile) fwrite(&hash, sizeof(hash), 1, recordFile);
+}
+
+bool GetRecordedStateHash(uint32_t *hash) {
+    if (!replayHashValid) return false;
+    *hash = replayHash;
+    return true;
+}
+
+void InjectAction(InputAction action, bool down, bool press) {
+    if (down) frame.held |= 1u << action;
+    else      frame.held &= ~(1u << action);
+    if (press) frame.pressed |= 1u << action;
+}
+
+// ----------------------------------------------------------------------
+//  Queries
+// ----------------------------------------------------------------------
+const InputFrame *GetInputFrame(void) {
+    return &frame;
+}
+
+float GetInputFrameTime(void) {
+    return frame.dt;
+}
+
+bool IsActionPressed(InputAction action) {
+    return (frame.pressed >> action) & 1u;
+}
+
+bool IsActionDown(InputAction action) {
+    return (frame.held >> action) & 1u;
+}
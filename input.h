@@ -0,0 +1,78 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define INPUT_MAX_EVENTS      32
+#define INPUT_MAX_CHARS       16
+#define INPUT_KEYS_PER_ACTION 2
+#define INPUT_KEY_CODES       512   // raylib keycodes all fit below this
+
+typedef enum {
+    ACTION_MENU_UP,
+    ACTION_MENU_DOWN,
+    ACTION_CONFIRM,
+    ACTION_LAUNCH,
+    ACTION_MOVE_LEFT,
+    ACTION_MOVE_RIGHT,
+    ACTION_YES,
+    ACTION_NO,
+    ACTION_FIRE,
+    ACTION_QUICK_SAVE,
+    ACTION_QUICK_LOAD,
+    ACTION_COUNT
+} InputAction;
+
+typedef struct InputEvent {
+    uint16_t key;
+    uint16_t reserved;
+    uint32_t actions;        // bitmask of the actions this key is bound to
+} InputEvent;
+
+// ----------------------------------------------------------------------
+//  Everything the game reads about input for one frame
+// ----------------------------------------------------------------------
+typedef struct InputFrame {
+    float dt;
+    uint32_t held;           // actions whose key is down this frame
+    uint32_t pressed;        // actions with a press event this frame
+    int eventCount;
+    InputEvent events[INPUT_MAX_EVENTS];
+    int charCount;
+    int chars[INPUT_MAX_CHARS];
+} InputFrame;
+
+void InitInput(void);
+
+// Drains raylib's key and char queues once (or reads the next recorded
+// frame when replaying). Call at the top of every frame.
+void PollInput(void);
+
+// Recording writes every polled frame; replay feeds recorded frames back
+// instead of the keyboard until the file runs out. The file also keeps the
+// random seed of the session, so the caller can reseed before replaying.
+bool StartInputRecording(const char *path, uint32_t seed);
+bool StartInputReplay(const char *path, uint32_t *seed);
+void StopInputRecording(void);
+bool IsInputReplaying(void);
+
+// The state hash of each frame goes right after it in the recording, so
+// a replay can be checked tick by tick. Call once the frame has run.
+// GetRecordedStateHash gives the replayed frame's hash, or false if there
+// is none (not replaying, or an old recording).
+void RecordStateHash(uint32_t hash);
+bool GetRecordedStateHash(uint32_t *hash);
+
+// Changes the current frame as if the action's key had been pressed, held
+// or let go; for game-driven input such as the autopilot. Happens after
+// recording, so a replay has to drive the same input again.
+void InjectAction(InputAction action, bool down, bool press);
+
+const InputFrame *GetInputFrame(void);
+float GetInputFrameTime(void);
+bool IsActionPressed(InputAction action);
+bool IsActionDown(InputAction action);
+
+#endif // INPUT_H
@@ -0,0 +1,64 @@
+#include "io_worker.h"
+
+#include <string.h>
+
+static void *IoWorkerMain(void *arg) {
+    IoWorker *worker = (IoWorker *)arg;
+
+    pthread_mutex_lock(&worker->lock);
+    for (;;) {
+        while (worker->count == 0 && !worker->quit) {
+            pthread_cond_wait(&worker->wake, &worker->lock);
+        }
+        if (worker->count == 0) break;   // quit requested and queue drained
+
+        IoJob job = worker->jobs[worker->head];
+        worker->head = (worker->head + 1) % IO_QUEUE_SIZE;
+        worker->count--;
+
+        pthread_mutex_unlock(&worker->lock);
+        job.func(job.payload);
+        pthread_mutex_lock(&worker->lock);
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return NULL;
+}
+
+bool StartIoWorker(IoWorker *worker) {
+    memset(worker, 0, sizeof(*worker));
+    pthread_mutex_init(&worker->lock, NULL);
+    pthread_cond_init(&worker->wake, NULL);
+
+    worker->running = pthread_create(&worker->thread, NULL, IoWorkerMain, worker) == 0;
+    return worker->running;
+}
+
+void StopIoWorker(IoWorker *worker) {
+    if (worker->running) {
+        pthread_mutex_lock(&worker->lock);
+        worker->quit = true;
+        pthread_cond_signal(&worker->wake);
+        pthread_mutex_unlock(&worker->lock);
+
+        pthread_join(worker->thread, NULL);
+        worker->running = false;
+    }
+    pthread_cond_destroy(&worker->wake);
+    pthread_mutex_destroy(&worker->lock);
+}
+
+bool PostIoJob(IoWorker *worker, IoJobFunc func, const void *payload, size_t size) {
+    if (!worker->running || size > IO_JOB_PAYLOAD) return false;
+
+    pthread_mutex_lock(&worker->lock);
+    bool queued = !worker->quit && worker->count < IO_QUEUE_SIZE;
+    if (queued) {
+        IoJob *job = &worker->jobs[(worker->head + worker->count) % IO_QUEUE_SIZE];
+        job->func = func;
+        if (size > 0) memcpy(job->payload, payload, size);
+        worker->count++;
+        pthread_cond_signal(&worker->wake);
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return queued;
+}
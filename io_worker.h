@@ -0,0 +1,43 @@
+#ifndef IO_WORKER_H
+#define IO_WORKER_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define IO_QUEUE_SIZE    16
+#define IO_JOB_PAYLOAD   256
+
+// The payload is a private copy made at post time, so the game is free to
+// change its own state as soon as PostIoJob returns.
+typedef void (*IoJobFunc)(void *payload);
+
+typedef struct IoJob {
+    IoJobFunc func;
+    _Alignas(8) unsigned char payload[IO_JOB_PAYLOAD];
+} IoJob;
+
+// ----------------------------------------------------------------------
+//  Single background thread for disk writes the game loop must not wait on
+// ----------------------------------------------------------------------
+typedef struct IoWorker {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;
+    IoJob jobs[IO_QUEUE_SIZE];
+    int head;
+    int count;
+    bool running;
+    bool quit;
+} IoWorker;
+
+bool StartIoWorker(IoWorker *worker);
+
+// Runs every queued job, then joins the thread.
+void StopIoWorker(IoWorker *worker);
+
+// Never waits for the disk. Returns false if the worker is not running or
+// the queue is full, in which case the caller decides what to do.
+bool PostIoJob(IoWorker *worker, IoJobFunc func, const void *payload, size_t size);
+
+#endif // IO_WORKER_H
@@ -0,0 +1,112 @@
+#include "job_pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "platform.h"
+
+// ----------------------------------------------------------------------
+//  Claims indices until the batch is exhausted
+// ----------------------------------------------------------------------
+static void RunBatch(JobPool *pool) {
+    for (;;) {
+        int index = atomic_fetch_add_explicit(&pool->next, 1, memory_order_relaxed);
+        if (index >= pool->count) break;
+        pool->func(pool->userData, index);
+    }
+}
+
+static void *WorkerMain(void *arg) {
+    JobPool *pool = (JobPool *)arg;
+    unsigned int seenGeneration = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->quit && pool->generation == seenGeneration) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->quit) break;
+
+        seenGeneration = pool->generation;
+        pool->busyWorkers++;
+        pthread_mutex_unlock(&pool->lock);
+
+        RunBatch(pool);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busyWorkers == 0) pthread_cond_signal(&pool->idle);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+// ----------------------------------------------------------------------
+//  Pool lifetime
+// ----------------------------------------------------------------------
+bool InitJobPool(JobPool *pool, int threadCount) {
+    memset(pool, 0, sizeof(*pool));
+    if (threadCount < 0) threadCount = GetCpuCount() - 1;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->idle, NULL);
+    atomic_init(&pool->next, 0);
+
+    if (threadCount == 0) return true;
+
+    pool->threads = malloc(sizeof(pthread_t) * threadCount);
+    if (!pool->threads) return false;
+
+    for (int i = 0; i < threadCount; i++) {
+        if (pthread_create(&pool->threads[i], NULL, WorkerMain, pool) != 0) break;
+        pool->threadCount++;
+    }
+    return pool->threadCount == threadCount;
+}
+
+void ShutdownJobPool(JobPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->quit = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->threadCount; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    free(pool->threads);
+
+    pthread_cond_destroy(&pool->idle);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    memset(pool, 0, sizeof(*pool));
+}
+
+// ----------------------------------------------------------------------
+//  Publishes a batch, helps run it, then waits for stragglers
+// ----------------------------------------------------------------------
+void ParallelFor(JobPool *pool, int count, JobFunc func, void *userData) {
+    if (count <= 0) return;
+
+    pthread_mutex_lock(&pool->lock);
+    // A worker that woke too late for the previous batch may still be
+    // draining its empty counter; never rewrite the batch under its feet.
+    while (pool->busyWorkers > 0) {
+        pthread_cond_wait(&pool->idle, &pool->lock);
+    }
+    pool->func     = func;
+    pool->userData = userData;
+    pool->count    = count;
+    atomic_store_explicit(&pool->next, 0, memory_order_relaxed);
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    RunBatch(pool);
+
+    // Workers that never got to this batch find it empty and leave at once,
+    // so it is enough to wait until nobody is inside RunBatch.
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busyWorkers > 0) {
+        pthread_cond_wait(&pool->idle, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
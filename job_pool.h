@@ -0,0 +1,40 @@
+#ifndef JOB_POOL_H
+#define JOB_POOL_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+
+// Called once per index; runs on any worker or on the calling thread.
+typedef void (*JobFunc)(void *userData, int index);
+
+// ----------------------------------------------------------------------
+//  Fixed set of worker threads for data-parallel loops
+// ----------------------------------------------------------------------
+typedef struct JobPool {
+    pthread_t *threads;
+    int threadCount;
+
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;
+    pthread_cond_t  idle;
+    unsigned int generation;    // bumped for every ParallelFor batch
+    int busyWorkers;
+    bool quit;
+
+    JobFunc func;
+    void *userData;
+    int count;
+    atomic_int next;            // next unclaimed index of the current batch
+} JobPool;
+
+// threadCount < 0 uses one worker per CPU (minus the calling thread);
+// 0 runs everything on the thread that calls ParallelFor.
+bool InitJobPool(JobPool *pool, int threadCount);
+void ShutdownJobPool(JobPool *pool);
+
+// Runs func(userData, i) for i in [0, count) and returns once all are done.
+// The calling thread helps, so a pool with zero workers still works.
+void ParallelFor(JobPool *pool, int count, JobFunc func, void *userData);
+
+#endif // JOB_POOL_H
@@ -0,0 +1,144 @@
+#include "leaderboard.h"
+
+#include <stddef.h>
+#include <string.h>
+#include "checksum.h"
+
+static uint32_t SlotChecksum(const LeaderboardSlot *slot) {
+    uint32_t crc = Crc32(0, &slot->count, sizeof(slot->count));
+    return Crc32(crc, slot->entries, slot->count * sizeof(LeaderboardEntry));
+}
+
+static bool IsSlotValid(const LeaderboardSlot *slot) {
+    return atomic_load(&slot->sequence) != 0 &&
+           slot->count <= LEADERBOARD_CAPACITY &&
+           slot->checksum == SlotChecksum(slot);
+}
+
+// ----------------------------------------------------------------------
+//  Opening: trust whichever valid slot is newest, not the header alone,
+//  since the header flip may not have reached the disk before a crash
+// ----------------------------------------------------------------------
+bool OpenLeaderboard(const char *path, Leaderboard *board) {
+    memset(board, 0, sizeof(*board));
+    if (!MapFileShared(path, sizeof(LeaderboardFile), &board->mapping)) return false;
+
+    LeaderboardFile *file = (LeaderboardFile *)board->mapping.data;
+    board->file = file;
+
+    bool known = memcmp(file->magic, LEADERBOARD_MAGIC, 4) == 0 && file->version == LEADERBOARD_VERSION;
+    bool valid[2] = { known && IsSlotValid(&file->slots[0]), known && IsSlotValid(&file->slots[1]) };
+
+    if (!valid[0] && !valid[1]) {
+        // New or unreadable file: start an empty board
+        memset(file, 0, sizeof(*file));
+        memcpy(file->magic, LEADERBOARD_MAGIC, 4);
+        file->version = LEADERBOARD_VERSION;
+        file->slots[0].checksum = SlotChecksum(&file->slots[0]);
+        atomic_store(&file->slots[0].sequence, 1);
+        atomic_store(&file->activeSlot, 0);
+        FlushMappedRange(&board->mapping, 0, sizeof(*file));
+        return true;
+    }
+
+    uint32_t active;
+    if (valid[0] && valid[1]) {
+        active = (atomic_load(&file->slots[1].sequence) > atomic_load(&file->slots[0].sequence)) ? 1 : 0;
+    }
+    else {
+        active = valid[1] ? 1 : 0;
+    }
+    atomic_store(&file->activeSlot, active);
+    return true;
+}
+
+void CloseLeaderboard(Leaderboard *board) {
+    UnmapFile(&board->mapping);
+    board->file = NULL;
+}
+
+// ----------------------------------------------------------------------
+//  Equal scores keep their order, so the older entry stays ahead
+// ----------------------------------------------------------------------
+static int InsertPosition(const LeaderboardEntry *entries, int count, uint32_t score) {
+    int low = 0, high = count;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (entries[mid].score >= score) low = mid + 1;
+        else                             high = mid;
+    }
+    return low;
+}
+
+bool InsertLeaderboardEntry(Leaderboard *board, const LeaderboardEntry *entry) {
+    LeaderboardFile *file = board->file;
+    if (!file) return false;
+
+    uint32_t active = atomic_load(&file->activeSlot);
+    const LeaderboardSlot *live = &file->slots[active];
+    LeaderboardSlot *spare      = &file->slots[active ^ 1];
+
+    int count    = (int)live->count;
+    int position = InsertPosition(live->entries, count, entry->score);
+    if (position >= LEADERBOARD_CAPACITY) return false;
+
+    // Readers check the sequence before and after copying, so zeroing it
+    // first makes any read that overlaps this rewrite retry
+    atomic_store_explicit(&spare->sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    int newCount = (count < LEADERBOARD_CAPACITY) ? count + 1 : LEADERBOARD_CAPACITY;
+    memcpy(spare->entries, live->entries, position * sizeof(LeaderboardEntry));
+    spare->entries[position] = *entry;
+    memcpy(&spare->entries[position + 1], &live->entries[position],
+           (newCount - position - 1) * sizeof(LeaderboardEntry));
+    spare->count    = (uint32_t)newCount;
+    spare->checksum = SlotChecksum(spare);
+    atomic_store_explicit(&spare->sequence, atomic_load(&live->sequence) + 1, memory_order_release);
+
+    size_t spareOffset = offsetof(LeaderboardFile, slots) + (active ^ 1) * sizeof(LeaderboardSlot);
+    if (!FlushMappedRange(&board->mapping, spareOffset, sizeof(LeaderboardSlot))) return false;
+
+    atomic_store_explicit(&file->activeSlot, active ^ 1, memory_order_release);
+    FlushMappedRange(&board->mapping, 0, offsetof(LeaderboardFile, slots));
+    return true;
+}
+
+// ----------------------------------------------------------------------
+//  Queries
+// ----------------------------------------------------------------------
+int GetLeaderboardTop(const Leaderboard *board, LeaderboardEntry *out, int n) {
+    LeaderboardFile *file = board->file;
+    if (!file || n <= 0) return 0;
+
+    for (;;) {
+        uint32_t active = atomic_load_explicit(&file->activeSlot, memory_order_acquire);
+        const LeaderboardSlot *slot = &file->slots[active];
+        uint32_t before = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+
+        int count = (int)slot->count;
+        if (count > LEADERBOARD_CAPACITY) count = LEADERBOARD_CAPACITY;
+        if (count > n) count = n;
+        memcpy(out, slot->entries, count * sizeof(LeaderboardEntry));
+
+        atomic_thread_fence(memory_order_acquire);
+        if (before != 0 && atomic_load_explicit(&slot->sequence, memory_order_relaxed) == before) {
+            return count;
+        }
+    }
+}
+
+int GetLeaderboardRank(const Leaderboard *board, uint32_t score) {
+    LeaderboardEntry entries[LEADERBOARD_CAPACITY];
+    int count = GetLeaderboardTop(board, entries, LEADERBOARD_CAPACITY);
+    return InsertPosition(entries, count, score) + 1;
+}
+
+int GetPlayerRank(const Leaderboard *board, const char *initials) {
+    LeaderboardEntry entries[LEADERBOARD_CAPACITY];
+    int count = GetLeaderboardTop(board, entries, LEADERBOARD_CAPACITY);
+    for (int i = 0; i < count; i++) {
+        if (strncmp(entries[i].initials, initials, sizeof(entries[i].initials)) == 0) return i + 1;
+    }
+    return 0;
+}
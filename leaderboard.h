@@ -0,0 +1,68 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "platform.h"
+
+#define LEADERBOARD_PATH        "leaderboard.dat"
+#define LEADERBOARD_MAGIC       "BKLB"
+#define LEADERBOARD_VERSION     1
+#define LEADERBOARD_CAPACITY    100
+
+typedef struct LeaderboardEntry {
+    char     initials[4];    // up to three letters, NUL padded
+    uint32_t score;
+    int64_t  timestamp;      // seconds since the epoch
+    uint16_t levelReached;
+    uint16_t reserved0;
+    uint32_t reserved1;
+} LeaderboardEntry;
+
+// One complete board. The file holds two, and updates always rewrite the
+// one that is not live, so a crash mid-write never damages the live board.
+typedef struct LeaderboardSlot {
+    _Atomic uint32_t sequence;   // 0 while the slot is being rewritten
+    uint32_t count;
+    uint32_t checksum;           // CRC-32 over count and the used entries
+    uint32_t reserved;
+    LeaderboardEntry entries[LEADERBOARD_CAPACITY];   // best first
+} LeaderboardSlot;
+
+typedef struct LeaderboardFile {
+    char     magic[4];
+    uint32_t version;
+    _Atomic uint32_t activeSlot;
+    uint32_t reserved;
+    LeaderboardSlot slots[2];
+} LeaderboardFile;
+
+// ----------------------------------------------------------------------
+//  Per-machine top-100 board in a fixed-size memory-mapped file
+//
+//  One writer (the I/O thread) and any number of readers. Queries copy
+//  out of the live slot and retry if it was swapped while they read.
+// ----------------------------------------------------------------------
+typedef struct Leaderboard {
+    MappedFile mapping;
+    LeaderboardFile *file;
+} Leaderboard;
+
+bool OpenLeaderboard(const char *path, Leaderboard *board);
+void CloseLeaderboard(Leaderboard *board);
+
+// Writer side: sorted insert into the spare slot, flush, then publish it.
+// Blocks on the disk, so run it on the I/O thread.
+bool InsertLeaderboardEntry(Leaderboard *board, const LeaderboardEntry *entry);
+
+// Reader side: copies up to n best entries, returns how many.
+int GetLeaderboardTop(const Leaderboard *board, LeaderboardEntry *out, int n);
+
+// 1-based place a score would take on the board (capacity + 1 if it misses).
+int GetLeaderboardRank(const Leaderboard *board, uint32_t score);
+
+// 1-based best place of a player, or 0 if they are not on the board.
+int GetPlayerRank(const Leaderboard *board, const char *initials);
+
+#endif // LEADERBOARD_H
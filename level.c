@@ -0,0 +1,174 @@
+#include "level.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "checksum.h"
+#include "rng.h"
+
+// ----------------------------------------------------------------------
+//  Standard grid placement used by generated levels
+// ----------------------------------------------------------------------
+Rectangle LevelGridRect(int row, int col) {
+    Rectangle rect;
+    rect.x      = col * (BLOCK_WIDTH + BLOCK_SPACING) + LEVEL_GRID_X;
+    rect.y      = row * (BLOCK_HEIGHT + BLOCK_SPACING) + LEVEL_GRID_Y;
+    rect.width  = BLOCK_WIDTH;
+    rect.height = BLOCK_HEIGHT;
+    return rect;
+}
+
+Color BlockHealthColor(int health) {
+    if      (health == 1) return GREEN;
+    else if (health == 2) return YELLOW;
+    else                  return RED;
+}
+
+// ----------------------------------------------------------------------
+//  Random level generation
+// ----------------------------------------------------------------------
+bool GenerateLevel(LevelData *level, int rows, int cols, uint32_t seed) {
+    memset(level, 0, sizeof(*level));
+    if (rows <= 0 || cols <= 0) return false;
+
+    level->blocks = calloc((size_t)rows * cols, sizeof(Block));
+    if (!level->blocks) return false;
+
+    level->rows       = rows;
+    level->cols       = cols;
+    level->blockCount = rows * cols;
+
+    RandomStream rng;
+    SeedRandomStream(&rng, seed, RANDOM_STREAM_LEVEL);
+
+    int blockIndex = 0;
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < cols; col++) {
+            Block *block  = &level->blocks[blockIndex++];
+            block->rect   = LevelGridRect(row, col);
+            block->active = true;
+            if (RandomValue(&rng, 1, EXPLOSIVE_BLOCK_CHANCE) == 1) {
+                block->health = 1;      // any blast sets it off
+                block->type   = BLOCK_EXPLOSIVE;
+                block->color  = ORANGE;
+            }
+            else {
+                block->health = RandomValue(&rng, 1, 3);
+                block->type   = BLOCK_NORMAL;
+                block->color  = BlockHealthColor(block->health);
+            }
+        }
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------
+//  Level files
+// ----------------------------------------------------------------------
+static bool CheckLevelHeader(const MappedFile *mapping) {
+    const LevelFileHeader *header = (const LevelFileHeader *)mapping->data;
+    return mapping->size >= sizeof(LevelFileHeader) &&
+           memcmp(header->magic, LEVEL_FILE_MAGIC, 4) == 0 &&
+           header->version == LEVEL_FILE_VERSION &&
+           header->blockSize == sizeof(Block) &&
+           header->blockCount <= INT32_MAX &&
+           header->blocksOffset % 4 == 0 &&
+           header->blocksOffset <= mapping->size &&
+           (mapping->size - header->blocksOffset) / sizeof(Block) >= header->blockCount;
+}
+
+bool LoadLevelFile(const char *path, LevelData *level) {
+    memset(level, 0, sizeof(*level));
+
+    MappedFile mapping;
+    if (!MapFile(path, &mapping)) return false;
+
+    const LevelFileHeader *header = (const LevelFileHeader *)mapping.data;
+    if (!CheckLevelHeader(&mapping)) {
+        UnmapFile(&mapping);
+        return false;
+    }
+
+    level->blocks     = (Block *)((unsigned char *)mapping.data + header->blocksOffset);
+    level->blockCount = (int)header->blockCount;
+    level->rows       = (int)header->rows;
+    level->cols       = (int)header->cols;
+    level->flags      = header->flags;
+    level->mapping    = mapping;
+    return true;
+}
+
+static bool IsValidBlock(const Block *block) {
+    const Rectangle *r = &block->rect;
+    // NaN fails every comparison, so this also rejects non-finite rects.
+    // active is read as a byte first: anything but 0/1 in a bool is undefined.
+    return ((const unsigned char *)&block->active)[0] <= 1 &&
+           block->type < BLOCK_TYPE_COUNT &&
+           block->health >= 0 &&
+           r->x > -1e9f && r->x < 1e9f && r->y > -1e9f && r->y < 1e9f &&
+           r->width > 0.0f && r->width < 1e9f && r->height > 0.0f && r->height < 1e9f;
+}
+
+bool LoadCheckedLevelFile(const char *path, LevelData *level) {
+    if (!LoadLevelFile(path, level)) return false;
+
+    for (int i = 0; i < level->blockCount; i++) {
+        if (!IsValidBlock(&level->blocks[i])) {
+            UnloadLevel(level);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ValidateLevelFile(const char *path, LevelFileHeader *header) {
+    MappedFile mapping;
+    if (!MapFile(path, &mapping)) return false;
+
+    bool valid = CheckLevelHeader(&mapping);
+    if (valid) {
+        const LevelFileHeader *fileHeader = (const LevelFileHeader *)mapping.data;
+        const Block *blocks = (const Block *)((unsigned char *)mapping.data + fileHeader->blocksOffset);
+        size_t blockBytes   = (size_t)fileHeader->blockCount * sizeof(Block);
+
+        valid = Crc32(0, blocks, blockBytes) == fileHeader->checksum;
+        for (uint32_t i = 0; valid && i < fileHeader->blockCount; i++) {
+            valid = IsValidBlock(&blocks[i]);
+        }
+        if (valid && header) *header = *fileHeader;
+    }
+
+    UnmapFile(&mapping);
+    return valid;
+}
+
+bool SaveLevelFile(const char *path, const LevelData *level) {
+    LevelFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LEVEL_FILE_MAGIC, 4);
+    header.version      = LEVEL_FILE_VERSION;
+    header.flags        = (uint16_t)level->flags;
+    header.rows         = (uint32_t)level->rows;
+    header.cols         = (uint32_t)level->cols;
+    header.blockCount   = (uint32_t)level->blockCount;
+    header.blockSize    = sizeof(Block);
+    header.checksum     = Crc32(0, level->blocks, (size_t)level->blockCount * sizeof(Block));
+    header.blocksOffset = LEVEL_BLOCKS_OFFSET;
+
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+
+    unsigned char padding[LEVEL_BLOCKS_OFFSET - sizeof(LevelFileHeader)] = { 0 };
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(padding, sizeof(padding), 1, file) == 1 &&
+              fwrite(level->blocks, sizeof(Block), (size_t)level->blockCount, file) == (size_t)level->blockCount;
+
+    if (fclose(file) != 0) ok = false;
+    return ok;
+}
+
+void UnloadLevel(LevelData *level) {
+    if (level->mapping.data) UnmapFile(&level->mapping);
+    else                     free(level->blocks);
+    memset(level, 0, sizeof(*level));
+}
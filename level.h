@@ -0,0 +1,95 @@
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "raylib.h"
+#include "platform.h"
+
+#define BLOCK_WIDTH    100
+#define BLOCK_HEIGHT   30
+#define BLOCK_SPACING  10
+#define LEVEL_GRID_X   100          // top left of the standard grid
+#define LEVEL_GRID_Y   50
+#define EXPLOSIVE_BLOCK_CHANCE 12   // one in N generated blocks
+
+typedef enum {
+    BLOCK_NORMAL = 0,
+    BLOCK_EXPLOSIVE,         // damages its neighbours when destroyed
+    BLOCK_TYPE_COUNT
+} BlockType;
+
+// The in-memory block is also the on-disk record, so keep it free of
+// pointers and mind the field order: 28 bytes, no interior padding.
+typedef struct Block {
+    Rectangle rect;
+    int health;
+    Color color;
+    unsigned char type;
+    bool active;
+} Block;
+
+typedef char BlockLayoutCheck[(sizeof(Block) == 28) ? 1 : -1];
+
+// ----------------------------------------------------------------------
+//  Binary level file (.bklv)
+//
+//  [LevelFileHeader][padding up to blocksOffset][Block x blockCount]
+//
+//  Little-endian, 4-byte aligned. The block array is mapped copy-on-write
+//  and used as the live block storage, so loading never touches a block.
+// ----------------------------------------------------------------------
+#define LEVEL_FILE_MAGIC    "BKLV"
+#define LEVEL_FILE_VERSION  1
+#define LEVEL_BLOCKS_OFFSET 64
+
+typedef enum {
+    LEVEL_FLAG_CUSTOM_RECTS = 1 << 0,   // rects are authored, not on the standard grid
+} LevelFlags;
+
+typedef struct LevelFileHeader {
+    char     magic[4];
+    uint16_t version;
+    uint16_t flags;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t blockCount;
+    uint32_t blockSize;      // sizeof(Block) of the writer, guards against layout drift
+    uint32_t checksum;       // CRC-32 over the block records
+    uint32_t reserved;
+    uint64_t blocksOffset;
+} LevelFileHeader;
+
+typedef struct LevelData {
+    Block *blocks;
+    int blockCount;
+    int rows;
+    int cols;
+    unsigned int flags;
+    MappedFile mapping;      // set when the blocks live in a mapped file
+} LevelData;
+
+// Fills a rows x cols grid with random 1-3 health blocks (heap storage).
+// The same seed always gives the same level, on any thread, and the same
+// health the headless sim deals out for that seed.
+bool GenerateLevel(LevelData *level, int rows, int cols, uint32_t seed);
+
+// Maps a .bklv file; only the header is checked, the blocks are used in place.
+// Fine for files a pack load already validated.
+bool LoadLevelFile(const char *path, LevelData *level);
+
+// LoadLevelFile plus one pass over the blocks (no checksum), for files
+// nothing has validated yet, e.g. a single level from the command line.
+bool LoadCheckedLevelFile(const char *path, LevelData *level);
+bool SaveLevelFile(const char *path, const LevelData *level);
+
+// Full check of a level file: header, checksum and every block record.
+// Meant for tooling and pack loading, not the per-round load path.
+bool ValidateLevelFile(const char *path, LevelFileHeader *header);
+
+void UnloadLevel(LevelData *level);
+
+Rectangle LevelGridRect(int row, int col);
+Color BlockHealthColor(int health);
+
+#endif // LEVEL_H
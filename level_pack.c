@@ -0,0 +1,107 @@
+#include "level_pack.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "raylib.h"
+#include "level.h"
+
+typedef struct ValidateBatch {
+    char **paths;
+    LevelFileHeader *headers;
+    bool *valid;
+} ValidateBatch;
+
+static void ValidateOne(void *userData, int index) {
+    ValidateBatch *batch = (ValidateBatch *)userData;
+    batch->valid[index] = ValidateLevelFile(batch->paths[index], &batch->headers[index]);
+}
+
+static int ComparePaths(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+// ----------------------------------------------------------------------
+//  Scan, validate in parallel, then pack the survivors into the index
+// ----------------------------------------------------------------------
+bool LoadLevelPack(const char *dirPath, JobPool *pool, LevelPack *pack) {
+    memset(pack, 0, sizeof(*pack));
+    if (!DirectoryExists(dirPath)) return false;
+
+    FilePathList files = LoadDirectoryFilesEx(dirPath, LEVEL_FILE_EXTENSION, false);
+    int fileCount = (int)files.count;
+    if (fileCount == 0) {
+        UnloadDirectoryFiles(files);
+        return false;
+    }
+
+    // Sort a private copy of the pointer array so pack order is stable
+    ValidateBatch batch;
+    batch.paths   = malloc(sizeof(char *) * fileCount);
+    batch.headers = malloc(sizeof(LevelFileHeader) * fileCount);
+    batch.valid   = malloc(sizeof(bool) * fileCount);
+    if (!batch.paths || !batch.headers || !batch.valid) {
+        free(batch.paths);
+        free(batch.headers);
+        free(batch.valid);
+        UnloadDirectoryFiles(files);
+        return false;
+    }
+    memcpy(batch.paths, files.paths, sizeof(char *) * fileCount);
+    qsort(batch.paths, fileCount, sizeof(char *), ComparePaths);
+
+    ParallelFor(pool, fileCount, ValidateOne, &batch);
+
+    size_t pathBytes = 0;
+    int validCount   = 0;
+    for (int i = 0; i < fileCount; i++) {
+        if (!batch.valid[i]) continue;
+        pathBytes += strlen(batch.paths[i]) + 1;
+        validCount++;
+    }
+
+    pack->rejected = fileCount - validCount;
+    if (validCount > 0) {
+        pack->entries = malloc(sizeof(LevelPackEntry) * validCount);
+        pack->paths   = malloc(pathBytes);
+    }
+
+    if (pack->entries && pack->paths) {
+        size_t offset = 0;
+        for (int i = 0; i < fileCount; i++) {
+            if (!batch.valid[i]) continue;
+
+            LevelPackEntry *entry = &pack->entries[pack->count++];
+            entry->pathOffset = (uint32_t)offset;
+            entry->blockCount = batch.headers[i].blockCount;
+            entry->rows       = (uint16_t)batch.headers[i].rows;
+            entry->cols       = (uint16_t)batch.headers[i].cols;
+            entry->checksum   = batch.headers[i].checksum;
+
+            size_t length = strlen(batch.paths[i]) + 1;
+            memcpy(pack->paths + offset, batch.paths[i], length);
+            offset += length;
+        }
+    }
+
+    free(batch.paths);
+    free(batch.headers);
+    free(batch.valid);
+    UnloadDirectoryFiles(files);
+
+    if (pack->count == 0) {
+        UnloadLevelPack(pack);
+        return false;
+    }
+    return true;
+}
+
+void UnloadLevelPack(LevelPack *pack) {
+    free(pack->entries);
+    free(pack->paths);
+    memset(pack, 0, sizeof(*pack));
+}
+
+const char *LevelPackPath(const LevelPack *pack, int index) {
+    if (index < 0 || index >= pack->count) return NULL;
+    return pack->paths + pack->entries[index].pathOffset;
+}
@@ -0,0 +1,35 @@
+#ifndef LEVEL_PACK_H
+#define LEVEL_PACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "job_pool.h"
+
+#define LEVEL_FILE_EXTENSION ".bklv"
+
+// 16 bytes per level; everything GameStarter needs before mapping the file
+typedef struct LevelPackEntry {
+    uint32_t pathOffset;     // into LevelPack.paths
+    uint32_t blockCount;
+    uint16_t rows;
+    uint16_t cols;
+    uint32_t checksum;
+} LevelPackEntry;
+
+// ----------------------------------------------------------------------
+//  Directory of validated levels, sorted by file name
+// ----------------------------------------------------------------------
+typedef struct LevelPack {
+    LevelPackEntry *entries;
+    int count;
+    int rejected;            // files that failed validation and were dropped
+    char *paths;             // NUL-separated full paths
+} LevelPack;
+
+// Scans dirPath for .bklv files and validates them in parallel on pool.
+bool LoadLevelPack(const char *dirPath, JobPool *pool, LevelPack *pack);
+void UnloadLevelPack(LevelPack *pack);
+
+const char *LevelPackPath(const LevelPack *pack, int index);
+
+#endif // LEVEL_PACK_H
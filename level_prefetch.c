@@ -0,0 +1,67 @@
+#include "level_prefetch.h"
+
+#include <string.h>
+
+#define PREFETCH_PAGE_SIZE 4096
+
+// ----------------------------------------------------------------------
+//  Worker: build the level (checking every block of a file, which is
+//  cheap off the main thread) and fault its pages in so the first frame
+//  of the new round never waits on the disk
+// ----------------------------------------------------------------------
+static void *PrefetchMain(void *arg) {
+    LevelPrefetch *prefetch = (LevelPrefetch *)arg;
+
+    bool ok = prefetch->path
+            ? LoadCheckedLevelFile(prefetch->path, &prefetch->level)
+            : GenerateLevel(&prefetch->level, prefetch->rows, prefetch->cols, prefetch->seed);
+
+    if (ok && prefetch->level.mapping.data) {
+        const volatile unsigned char *bytes = (const volatile unsigned char *)prefetch->level.mapping.data;
+        unsigned char sink = 0;
+        for (size_t offset = 0; offset < prefetch->level.mapping.size; offset += PREFETCH_PAGE_SIZE) {
+            sink ^= bytes[offset];
+        }
+        (void)sink;
+    }
+
+    atomic_store_explicit(&prefetch->state, ok ? PREFETCH_READY : PREFETCH_FAILED, memory_order_release);
+    return NULL;
+}
+
+void StartLevelPrefetch(LevelPrefetch *prefetch, const char *path, int rows, int cols, uint32_t seed) {
+    CancelLevelPrefetch(prefetch);
+
+    prefetch->path = path;
+    prefetch->rows = rows;
+    prefetch->cols = cols;
+    prefetch->seed = seed;
+    memset(&prefetch->level, 0, sizeof(prefetch->level));
+    atomic_store_explicit(&prefetch->state, PREFETCH_RUNNING, memory_order_relaxed);
+
+    prefetch->started = pthread_create(&prefetch->thread, NULL, PrefetchMain, prefetch) == 0;
+    if (!prefetch->started) {
+        // No thread available: build inline so the caller still gets a level
+        PrefetchMain(prefetch);
+    }
+}
+
+bool TakePrefetchedLevel(LevelPrefetch *prefetch, LevelData *level) {
+    if (prefetch->started) {
+        pthread_join(prefetch->thread, NULL);
+        prefetch->started = false;
+    }
+
+    int state = atomic_load_explicit(&prefetch->state, memory_order_acquire);
+    atomic_store_explicit(&prefetch->state, PREFETCH_IDLE, memory_order_relaxed);
+    if (state != PREFETCH_READY) return false;
+
+    *level = prefetch->level;
+    memset(&prefetch->level, 0, sizeof(prefetch->level));
+    return true;
+}
+
+void CancelLevelPrefetch(LevelPrefetch *prefetch) {
+    LevelData level;
+    if (TakePrefetchedLevel(prefetch, &level)) UnloadLevel(&level);
+}
@@ -0,0 +1,40 @@
+#ifndef LEVEL_PREFETCH_H
+#define LEVEL_PREFETCH_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include "level.h"
+
+typedef enum {
+    PREFETCH_IDLE,
+    PREFETCH_RUNNING,
+    PREFETCH_READY,
+    PREFETCH_FAILED
+} PrefetchState;
+
+// ----------------------------------------------------------------------
+//  Builds the next level on a background thread while a screen is shown
+// ----------------------------------------------------------------------
+typedef struct LevelPrefetch {
+    pthread_t thread;
+    atomic_int state;        // PrefetchState, published by the worker
+    bool started;            // a thread exists and has not been joined
+
+    const char *path;        // level file to map, or NULL to generate
+    int rows;
+    int cols;
+    uint32_t seed;
+    LevelData level;         // owned by the worker until READY
+} LevelPrefetch;
+
+// path == NULL generates a rows x cols level from seed instead of mapping a file.
+void StartLevelPrefetch(LevelPrefetch *prefetch, const char *path, int rows, int cols, uint32_t seed);
+
+// Hands the prefetched level over (waiting if it is still being built).
+// Returns false when nothing was started or the build failed.
+bool TakePrefetchedLevel(LevelPrefetch *prefetch, LevelData *level);
+
+void CancelLevelPrefetch(LevelPrefetch *prefetch);
+
+#endif // LEVEL_PREFETCH_H
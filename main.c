@@ -1,22 +1,37 @@
 #include <math.h>
+#include <stdatomic.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include "raylib.h"
+#include "level.h"
+#include "level_pack.h"
+#include "level_prefetch.h"
+#include "platform.h"
+#include "io_worker.h"
+#include "save_data.h"
+#include "leaderboard.h"
+#include "input.h"
+#include "sequence_matcher.h"
+#include "state_machine.h"
+#include "ecs.h"
+#include "particles.h"
+#include "column_index.h"
+#include "projectiles.h"
+#include "chain_reaction.h"
+#include "timer_wheel.h"
+#include "autopilot.h"
+#include "trajectory_cache.h"
+#include "rng.h"
+#include "fixed_physics.h"
+#include "checksum.h"
+#include "snapshot.h"
 
 #define SCREEN_WIDTH   1800
 #define SCREEN_HEIGHT  900
 #define ROWS           14
 #define COLUMNS        14
-#define MAX_BLOCKS     (ROWS * COLUMNS)
-#define BLOCK_WIDTH    100
-#define BLOCK_HEIGHT   30
-#define BLOCK_SPACING  10
-
-typedef struct Block {
-    Rectangle rect;
-    int health;
-    bool active;
-    Color color;
-} Block;
 
 typedef struct {
     int currentRows;
@@ -33,144 +48,404 @@ typedef enum {
     NOT_STARTED,
     GAME_OVER,
     GAME_WIN,
-    GAME_PLAYING
+    GAME_PLAYING,
+    GAME_STATE_COUNT
 } GameFlowState;
 
+// What a pickup looks like and how long its effect lasts (0 = instant)
+typedef struct {
+    const char *label;
+    Color color;
+    float duration;
+} PowerUpDesc;
+
+// A ball touched a block this frame; effects react after collision is done
+typedef struct {
+    int index;               // into currentLevel.blocks
+    bool destroyed;
+} BlockHit;
+
+typedef enum {
+    EVENT_START,      // play, restart or next level
+    EVENT_DIED,
+    EVENT_CLEARED
+} GameFlowEvent;
+
 // ----------------------------------------------------------------------
 //  Global variables
 // ----------------------------------------------------------------------
-GameFlowState currentState;
+StateMachine gameFlow;
+bool quitRequested = false;
+int menuOption     = 0;     // shared by the title and game over menus
 int startHP = 10;
 
 // Blocks / Player
 BlocksRow level          = {2, 14};
 PlayerDataManager player = {10, 0.0f, 0.0f};
-Block blocks[MAX_BLOCKS];
-
-// Paddle
-float playerX;
-float playerY;
+LevelData currentLevel;
+const char *levelPath    = NULL;   // set from the command line to play an authored level
+LevelPack levelPack;               // or a whole directory of them
+int packLevel            = 0;
+LevelPrefetch nextLevel;           // built in the background while WinScreen shows
+IoWorker ioWorker;                 // saves happen here so quitting never waits on the disk
+
+// Highscore saves are coalesced into one pending value the I/O thread
+// picks up, so while it runs it is the only writer of the save file
+_Atomic uint32_t pendingHighscore   = 0;       // bits of the float to save next
+atomic_bool highscoreSavePosted     = false;   // a queued job has yet to read it
+atomic_bool highscoreSaveMissed     = false;   // the queue was full; save again later
+Leaderboard leaderboard;
+char playerInitials[4]   = "AAA";
+int levelNumber          = 1;
+
+// Every roll comes from the session seed: each round gets a seed of its
+// own, and each subsystem its own stream of that, so replays and
+// prefetched levels come out the same whatever order things happen in
+uint32_t gameSeed        = 0;
+uint32_t roundNumber     = 0;      // rounds started this session
+RandomStream launchRandom;
+RandomStream ballRandom;
+RandomStream pickupRandom;
+
+// Paddle, balls and pickups live in the entity world; blocks stay in currentLevel
+EcsWorld world;
+EcsEntity paddle   = ECS_INVALID_ENTITY;
+EcsEntity mainBall = ECS_INVALID_ENTITY;   // dead handle while waiting for launch
 float movementSpeed = 2000.0f;
+const float PADDLE_WIDTH  = SCREEN_WIDTH / 20.0f;
+const float PADDLE_HEIGHT = SCREEN_HEIGHT / 50.0f;
+const float BALL_SPEED    = 1000.0f;
+const float BALL_RADIUS   = 8.0f;
 
-// Single main ball (now using Vector2 + bool)
-bool    ball_active = false;
-Vector2 ballPos;
-Vector2 ballSpeed;
-const float BALL_SPEED  = 1000.0f;
-const float BALL_RADIUS = 8.0f;
-
-// Control flow booleans
-bool gameStarted = false;
-bool isAlive     = true;
-bool gameWon     = false;
-
-// Konami code
+// Cheat and service codes (Konami code built in, more from codes.cfg)
 const int KONAMI_CODE[] = {
     KEY_UP, KEY_UP, KEY_DOWN, KEY_DOWN,
     KEY_LEFT, KEY_RIGHT, KEY_LEFT, KEY_RIGHT,
     KEY_B, KEY_A
 };
 const int KONAMI_CODE_LENGTH = 10;
-int konamiIndex = 0;
-
-// Extra balls (unchanged)
-bool  fourBallsSpawned    = false;
-bool  extraBallsActive[4] = { false, false, false, false };
-float extraBallX[4];
-float extraBallY[4];
-float extraBallSpeedX[4];
-float extraBallSpeedY[4];
+const char *CODES_PATH = "codes.cfg";
+SequenceMatcher cheatCodes;
+
+// Extra balls
+bool fourBallsSpawned = false;
+
+// Block hit events and the debris they throw
+#define MAX_BLOCK_HITS 512         // room for a full tick of chain reaction blasts
+BlockHit blockHits[MAX_BLOCK_HITS];
+int blockHitCount = 0;
+ParticlePool particles;
+
+// Power-ups dropped by destroyed blocks
+#define MAX_PICKUPS        32
+#define PICKUP_DROP_CHANCE 8        // one in N destroyed blocks drops something
+const float PICKUP_RADIUS     = 12.0f;
+const float PICKUP_FALL_SPEED = 250.0f;
+const PowerUpDesc POWERUPS[POWERUP_KIND_COUNT] = {
+    //                       label  color    duration
+    [POWERUP_MULTIBALL]   = { "M",  YELLOW,   0.0f },
+    [POWERUP_WIDE_PADDLE] = { "W",  SKYBLUE, 10.0f },
+    [POWERUP_SLOW_BALL]   = { "S",  GREEN,    8.0f },
+    [POWERUP_LASER]       = { "L",  RED,     10.0f },
+};
+bool powerUpActive[POWERUP_KIND_COUNT];
+TimerId powerUpTimers[POWERUP_KIND_COUNT];  // when each timed effect runs out
+float ballSpeedScale = 1.0f;            // slow ball scales integration, not velocity
+bool fixedPhysics    = false;           // integer ball and paddle physics, see fixed_physics.h
+
+// Laser shots, resolved per block column
+#define MAX_LASER_HITS 256
+const float LASER_FIRE_INTERVAL = 0.08f;
+ProjectilePool lasers;
+ColumnIndex blockColumns;               // rebuilt whenever a round loads its level
+float laserCooldown = 0.0f;
+
+// Explosive blocks going off, a budget per frame
+ChainReaction chain;
+
+// Autopilot for soak tests and demos: plays through the same input actions
+// a player would use, menus included
+typedef enum {
+    AUTOPILOT_OFF,
+    AUTOPILOT_CATCH,            // meet every ball
+    AUTOPILOT_AIM,              // and send it at the lowest block left
+} AutopilotMode;
+AutopilotMode autopilot = AUTOPILOT_OFF;
+int autopilotTarget     = -1;   // block being aimed at
+TrajectoryCache trajectories;   // ball paths for the autopilot, only built when it runs
+double ballClock        = 0.0;  // seconds of ball travel this round, slow ball included
+
+// Replay checking: the world is hashed after every frame and the hash
+// recorded with that frame's input, so a replay shows the first frame
+// that plays out differently
+uint32_t tickNumber       = 0;      // frames run this session
+uint32_t checkedTicks     = 0;      // of those, compared against a recorded hash
+uint32_t divergedTick     = 0;      // first that didn't match, 0 while all have
+bool checkReplay          = false;  // --check-replay: stop at the first difference
+bool replayCheckFailed    = false;
+
+// F5 / F9 quick save and load of the round in progress
+Snapshot quickSave;
+
+// Timed game events, on a clock of 1 ms simulation ticks
+#define GAME_TIMER_CAPACITY 64      // plus one per block when blocks regenerate
+#define TICKS_PER_SECOND    1000.0
+typedef enum TimerKind {
+    TIMER_POWERUP_EXPIRE,       // arg: PowerUpKind
+    TIMER_BLOCK_RESPAWN,        // arg: block index
+} TimerKind;
+TimerWheel timers;
+double simClock = 0.0;                  // seconds of play this round
+
+// Endless mode: destroyed blocks come back after a while
+const float BLOCK_RESPAWN_DELAY = 20.0f;
+const float BLOCK_RESPAWN_RETRY = 1.0f; // a ball is in the way, try again shortly
+bool blockRegeneration = false;
+int *blockSpawnHealth = NULL;           // health each block comes back with
+int liveBlocks = 0;                     // active blocks, kept by DamageBlock and RespawnBlock
+uint32_t blockDigest = 0;               // XOR of BlockHashTerm over all blocks, kept the same way
 
 // ----------------------------------------------------------------------
 // Forward declarations
 // ----------------------------------------------------------------------
 void GameStarter(void);
+void LeaveRound(void);
+void ResetMenu(void);
 void InitializeGame(void);
+void DrawTitleMenu(void);
 void InitializeBlocks(void);
 void UpdateGame(void);
 void DrawGame(void);
 void GameOver(void);
+void DrawGameOver(void);
 void WinScreen(void);
-bool IsAnyKeyPressed(void);
+void DrawWinScreen(void);
+void InitGameFlow(void);
 void Upgrades(void);
 void levelReset(void);
 void dataLoader(bool load);
 bool AllBlocksCleared(void);
 void SpawnFourBallsIfNeeded(void);
-void GameState(void);
-void CheckBlockCollision(float *posX, float *posY, float radius, float *speedX, float *speedY);
+void SpawnFourBalls(void);
+void SpawnPaddle(void);
+EcsEntity SpawnBall(Vector2 position, Vector2 speed, Color color, bool isMain);
+void SpawnPickup(Vector2 position, PowerUpKind kind);
+void ClearBalls(void);
+void ApplyPowerUp(PowerUpKind kind);
+bool IsPowerUpActive(PowerUpKind kind);
+void PaddleControlSystem(float dt);
+void BallMovementSystem(float dt);
+void PickupFallSystem(float dt);
+void PaddleContactSystem(void);
+void BlockCollisionSystem(void);
+void PowerUpEffectSystem(void);
+void FireGameTimer(void *userData, int kind, int arg);
+void DrawPaddleSystem(void);
+void DrawBallsSystem(void);
+void DrawPickupsSystem(void);
+void RecordBlockHit(int index, bool destroyed);
+void BlockHitSystem(void);
+void LaserSystem(float dt);
+void DamageBlock(int index);
+void RespawnBlock(int index);
+void PrepareBlockTracking(void);
+void ChainReactionSystem(void);
+void AutopilotSystem(float dt);
+void AutopilotMenus(void);
+int PickAutopilotTarget(float crossX);
+void InitCheatCodes(void);
+void ApplyCodeAction(const char *action);
+bool CheckBlockCollision(float *posX, float *posY, float radius, float *speedX, float *speedY);
+void LoadLevelArgument(const char *path);
+void ParseArguments(int argc, char **argv);
+const char *CurrentLevelPath(void);
+void PrepareNextLevel(void);
+void SubmitScore(void);
+void DrawLeaderboard(int x, int y);
+uint32_t BlockHashTerm(int index);
+uint32_t HashWorldState(void);
+void CheckStateHash(void);
+bool SaveGameSnapshot(Snapshot *snapshot);
+bool LoadGameSnapshot(Snapshot *snapshot);
+void QuickSaveSystem(void);
 
 // ----------------------------------------------------------------------
-//  Determine the current game state based on booleans
+//  Game flow: who runs in which state, and what moves between them
 // ----------------------------------------------------------------------
-void GameState(void) {
-    if (!gameStarted) {
-        currentState = NOT_STARTED;
-    }
-    else if (!isAlive && !gameWon) {
-        currentState = GAME_OVER;
-    }
-    else if (gameWon) {
-        currentState = GAME_WIN;
-    }
-    else {
-        currentState = GAME_PLAYING;
-    }
+const StateDesc GAME_STATES[GAME_STATE_COUNT] = {
+    //                 name           enter              exit        update          draw
+    [NOT_STARTED]  = { "MENU",        ResetMenu,         NULL,       InitializeGame, DrawTitleMenu },
+    [GAME_OVER]    = { "GAME_OVER",   ResetMenu,         NULL,       GameOver,       DrawGameOver },
+    [GAME_WIN]     = { "GAME_WIN",    PrepareNextLevel,  NULL,       WinScreen,      DrawWinScreen },
+    [GAME_PLAYING] = { "PLAYING",     GameStarter,       LeaveRound, UpdateGame,     DrawGame },
+};
+
+void InitGameFlow(void) {
+    InitStateMachine(&gameFlow, GAME_STATES, GAME_STATE_COUNT);
+    AddStateTransition(&gameFlow, NOT_STARTED,  EVENT_START,   GAME_PLAYING);
+    AddStateTransition(&gameFlow, GAME_PLAYING, EVENT_DIED,    GAME_OVER);
+    AddStateTransition(&gameFlow, GAME_PLAYING, EVENT_CLEARED, GAME_WIN);
+    AddStateTransition(&gameFlow, GAME_OVER,    EVENT_START,   GAME_PLAYING);
+    AddStateTransition(&gameFlow, GAME_WIN,     EVENT_START,   GAME_PLAYING);
+    StartStateMachine(&gameFlow, NOT_STARTED);
 }
 
 // ----------------------------------------------------------------------
 //  Unified collision check for main + extra balls
 // ----------------------------------------------------------------------
-void CheckBlockCollision(float *posX, float *posY, float radius, float *speedX, float *speedY) {
-    for (int i = 0; i < MAX_BLOCKS; i++) {
+bool CheckBlockCollision(float *posX, float *posY, float radius, float *speedX, float *speedY) {
+    Block *blocks = currentLevel.blocks;
+    FixedCircle circle = ToFixedCircle((Vector2){ *posX, *posY }, radius);
+    for (int i = 0; i < currentLevel.blockCount; i++) {
         if (blocks[i].active &&
-            CheckCollisionCircleRec((Vector2){*posX, *posY}, radius, blocks[i].rect)) {
+            (fixedPhysics ? FixedCircleTouchesRect(circle, blocks[i].rect)
+                      : CheckCollisionCircleRec((Vector2){*posX, *posY}, radius, blocks[i].rect))) {
 
-            blocks[i].health--;
-            if (blocks[i].health <= 0) {
-                blocks[i].active = false;
-                player.currentScore += 100;
-            }
+            DamageBlock(i);
             // Reverse only the Y speed
             *speedY *= -1.0f;
-            break;
+            return true;
         }
     }
+    return false;
+}
+
+// ----------------------------------------------------------------------
+//  One point of damage from a ball or a shot
+// ----------------------------------------------------------------------
+void DamageBlock(int index) {
+    Block *block = &currentLevel.blocks[index];
+    if (!block->active) return;     // two shots can reach the same block in one frame
+
+    blockDigest ^= BlockHashTerm(index);
+    block->health--;
+    if (block->health <= 0) {
+        block->active = false;
+        liveBlocks--;
+        player.currentScore += 100;
+        if (block->type == BLOCK_EXPLOSIVE) IgniteBlock(&chain, index);
+        InvalidateBlockTrajectories(&trajectories, &currentLevel, index);
+        if (blockSpawnHealth) {     // only there when blocks regenerate
+            ScheduleTimer(&timers, (uint64_t)(BLOCK_RESPAWN_DELAY * TICKS_PER_SECOND), TIMER_BLOCK_RESPAWN, index);
+        }
+    }
+    blockDigest ^= BlockHashTerm(index);
+    RecordBlockHit(index, !block->active);
+}
+
+// ----------------------------------------------------------------------
+//  A regenerating block's respawn came due
+// ----------------------------------------------------------------------
+void RespawnBlock(int index) {
+    Block *block = &currentLevel.blocks[index];
+    if (block->active) return;
+
+    // Coming back on top of a ball would trap it inside the block
+    EcsIter it = QueryEntities(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_COLLIDER) | ECS_MASK(COMP_BALL));
+    while (NextChunk(&it)) {
+        Vector2 *position           = IterColumn(&it, COMP_POSITION);
+        ColliderComponent *collider = IterColumn(&it, COMP_COLLIDER);
+        for (int i = 0; i < it.count; i++) {
+            if (CheckCollisionCircleRec(position[i], collider[i].radius, block->rect)) {
+                ScheduleTimer(&timers, (uint64_t)(BLOCK_RESPAWN_RETRY * TICKS_PER_SECOND), TIMER_BLOCK_RESPAWN, index);
+                return;
+            }
+        }
+    }
+
+    blockDigest ^= BlockHashTerm(index);
+    block->health = blockSpawnHealth[index];
+    block->active = true;
+    blockDigest ^= BlockHashTerm(index);
+    liveBlocks++;
+    InvalidateBlockTrajectories(&trajectories, &currentLevel, index);
+}
+
+// ----------------------------------------------------------------------
+//  Counts the round's live blocks, starts their digest, and in endless
+//  mode remembers the health they start with. The only full pass over the
+//  blocks per round.
+// ----------------------------------------------------------------------
+void PrepareBlockTracking(void) {
+    free(blockSpawnHealth);
+    blockSpawnHealth = NULL;
+    if (blockRegeneration && currentLevel.blockCount > 0) {
+        blockSpawnHealth = malloc(sizeof(int) * currentLevel.blockCount);
+        if (!blockSpawnHealth) TraceLog(LOG_WARNING, "LEVEL: No respawn table, blocks will not regenerate");
+    }
+
+    liveBlocks  = 0;
+    blockDigest = 0;
+    for (int i = 0; i < currentLevel.blockCount; i++) {
+        if (currentLevel.blocks[i].active) liveBlocks++;
+        blockDigest ^= BlockHashTerm(i);
+        if (blockSpawnHealth) blockSpawnHealth[i] = currentLevel.blocks[i].health;
+    }
+}
+
+void RecordBlockHit(int index, bool destroyed) {
+    if (blockHitCount < MAX_BLOCK_HITS) {
+        blockHits[blockHitCount++] = (BlockHit){ index, destroyed };
+    }
 }
 
 // ----------------------------------------------------------------------
 //  Checks if all blocks are cleared
 // ----------------------------------------------------------------------
 bool AllBlocksCleared(void) {
-    for (int i = 0; i < MAX_BLOCKS; i++) {
-        if (blocks[i].active) return false;
-    }
-    return true;
+    return liveBlocks <= 0;
 }
 
 // ----------------------------------------------------------------------
 //  Sets up block positions, health, and colors
+//  (maps the authored level file when one was given, otherwise generates)
 // ----------------------------------------------------------------------
 void InitializeBlocks(void) {
-    int blockIndex = 0;
-    for (int row = 0; row < level.currentRows; row++) {
-        for (int col = 0; col < level.currentCols; col++) {
-            if (blockIndex >= MAX_BLOCKS) break;
-            blocks[blockIndex].rect.x = col * (BLOCK_WIDTH + BLOCK_SPACING) + 100;
-            blocks[blockIndex].rect.y = row * (BLOCK_HEIGHT + BLOCK_SPACING) + 50;
-            blocks[blockIndex].rect.width  = BLOCK_WIDTH;
-            blocks[blockIndex].rect.height = BLOCK_HEIGHT;
+    UnloadLevel(&currentLevel);
+
+    if (TakePrefetchedLevel(&nextLevel, &currentLevel)) return;
+
+    // Re-mapping hands back pristine copy-on-write pages for the new round.
+    // Pack levels were validated when the pack loaded, a lone file was not.
+    const char *path = CurrentLevelPath();
+    if (path) {
+        bool loaded = (levelPack.count > 0) ? LoadLevelFile(path, &currentLevel)
+                                            : LoadCheckedLevelFile(path, &currentLevel);
+        if (loaded) return;
+        TraceLog(LOG_WARNING, "LEVEL: Failed to load %s, generating instead", path);
+        if (levelPack.count == 0) levelPath = NULL;
+    }
 
-            blocks[blockIndex].health = GetRandomValue(1, 3);
-            blocks[blockIndex].active = true;
+    int rows = (level.currentRows > ROWS) ? ROWS : level.currentRows;
+    uint32_t seed = DeriveSeed(gameSeed, roundNumber);
+    GenerateLevel(&currentLevel, rows, level.currentCols, seed);
+    TraceLog(LOG_INFO, "LEVEL: Generated %dx%d from seed %u", rows, level.currentCols, seed);
+}
 
-            if      (blocks[blockIndex].health == 1) blocks[blockIndex].color = GREEN;
-            else if (blocks[blockIndex].health == 2) blocks[blockIndex].color = YELLOW;
-            else                                      blocks[blockIndex].color = RED;
+// ----------------------------------------------------------------------
+//  File backing the current level, or NULL for generated levels
+// ----------------------------------------------------------------------
+const char *CurrentLevelPath(void) {
+    if (levelPack.count > 0) return LevelPackPath(&levelPack, packLevel);
+    return levelPath;
+}
 
-            blockIndex++;
-        }
+// ----------------------------------------------------------------------
+//  Advances to the next level and starts building it in the background,
+//  so confirming on the win screen only has to swap it in
+// ----------------------------------------------------------------------
+void PrepareNextLevel(void) {
+    levelNumber++;
+    if (levelPack.count > 0) {
+        packLevel = (packLevel + 1) % levelPack.count;
+    }
+    else {
+        level.currentRows *= 2; // Doubling rows for next level
+        levelReset();
     }
+
+    int rows = (level.currentRows > ROWS) ? ROWS : level.currentRows;
+    StartLevelPrefetch(&nextLevel, CurrentLevelPath(), rows, level.currentCols, DeriveSeed(gameSeed, roundNumber + 1));
 }
 
 // ----------------------------------------------------------------------
@@ -178,23 +453,70 @@ void InitializeBlocks(void) {
 // ----------------------------------------------------------------------
 void GameStarter(void) {
     player.currentScore = 0;
-    isAlive             = true;
-    gameStarted         = true;
-    gameWon             = false;
+    roundNumber++;
+    uint32_t roundSeed = DeriveSeed(gameSeed, roundNumber);
+    SeedRandomStream(&launchRandom, roundSeed, RANDOM_STREAM_LAUNCH);
+    SeedRandomStream(&ballRandom, roundSeed, RANDOM_STREAM_BALLS);
+    SeedRandomStream(&pickupRandom, roundSeed, RANDOM_STREAM_PICKUPS);
     InitializeBlocks();
     fourBallsSpawned    = false;
 
-    // Paddle positions
-    playerX = SCREEN_WIDTH / 2.0f;
-    playerY = SCREEN_HEIGHT - 150.0f;
+    FreeColumnIndex(&blockColumns);
+    if (!BuildColumnIndex(&blockColumns, &currentLevel)) {
+        TraceLog(LOG_WARNING, "LEVEL: No column index, lasers will pass through blocks");
+    }
+    FreeChainReaction(&chain);
+    if (!InitChainReaction(&chain, currentLevel.blockCount)) {
+        TraceLog(LOG_WARNING, "LEVEL: No chain reaction queue, explosive blocks will not go off");
+    }
+    PrepareBlockTracking();
+    FreeTimerWheel(&timers);
+    if (!InitTimerWheel(&timers, GAME_TIMER_CAPACITY + (blockSpawnHealth ? currentLevel.blockCount : 0))) {
+        TraceLog(LOG_WARNING, "GAME: No timer wheel, power-ups will not run out");
+    }
+    simClock = 0.0;
+
+    // Fresh world: paddle first, then the main ball just above it
+    ClearEcsWorld(&world);
+    ClearParticles(&particles);
+    blockHitCount = 0;
+    memset(powerUpActive, 0, sizeof(powerUpActive));
+    memset(powerUpTimers, 0, sizeof(powerUpTimers));
+    ballSpeedScale = 1.0f;
+    ClearProjectiles(&lasers);
+    laserCooldown  = 0.0f;
+    autopilotTarget = -1;
+    SpawnPaddle();
+
+    Vector2 *paddlePos = GetComponent(&world, paddle, COMP_POSITION);
+    mainBall = SpawnBall((Vector2){ paddlePos->x + 40.0f, paddlePos->y - 40.0f },
+                         (Vector2){ BALL_SPEED, -BALL_SPEED }, WHITE, true);
+
+    FreeTrajectoryCache(&trajectories);
+    ballClock = 0.0;
+    if (autopilot != AUTOPILOT_OFF &&
+        !InitTrajectoryCache(&trajectories, ECS_MAX_ENTITIES, &currentLevel, SCREEN_WIDTH,
+                             paddlePos->y - BALL_RADIUS, TRAJECTORY_MAX_BOUNCES)) {
+        TraceLog(LOG_WARNING, "GAME: No trajectory cache, the autopilot will ignore blocks");
+    }
+}
 
-    // Main ball setup (Vector2)
-    ball_active = true;
-    ballPos     = (Vector2){ playerX + 40.0f, playerY - 40.0f };
-    ballSpeed   = (Vector2){ BALL_SPEED, -BALL_SPEED };
+// ----------------------------------------------------------------------
+//  Round is over: record it and release the level while menus show
+// ----------------------------------------------------------------------
+void LeaveRound(void) {
+    SubmitScore();
+    FreeColumnIndex(&blockColumns);
+    FreeChainReaction(&chain);
+    FreeTimerWheel(&timers);
+    FreeTrajectoryCache(&trajectories);
+    free(blockSpawnHealth);
+    blockSpawnHealth = NULL;
+    UnloadLevel(&currentLevel);
+}
 
-    // Deactivate extra balls
-    for (int i = 0; i < 4; i++) extraBallsActive[i] = false;
+void ResetMenu(void) {
+    menuOption = 0;
 }
 
 // ----------------------------------------------------------------------
@@ -202,31 +524,31 @@ void GameStarter(void) {
 // ----------------------------------------------------------------------
 void InitializeGame(void)
 {
-    static int menuOption = 0;
-
-    if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W)) {
+    if (IsActionPressed(ACTION_MENU_UP)) {
         menuOption--;
         if (menuOption < 0) {
             menuOption = 1;
         }
     }
-    else if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S)) {
+    else if (IsActionPressed(ACTION_MENU_DOWN)) {
         menuOption++;
         if (menuOption > 1) {
             menuOption = 0;
         }
     }
 
-    if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE)) {
+    if (IsActionPressed(ACTION_CONFIRM)) {
         if (menuOption == 0) {
-            GameStarter();
+            SendStateEvent(&gameFlow, EVENT_START);
         }
         else {
-            dataLoader(false);
-            CloseWindow();
+            quitRequested = true;
         }
     }
+}
 
+void DrawTitleMenu(void)
+{
     DrawText("Block Kuzushi", SCREEN_WIDTH/2 - 340, SCREEN_HEIGHT/3 - 100, 100, WHITE);
 
     Color playColor = (menuOption == 0) ? GREEN : GRAY;
@@ -241,28 +563,59 @@ void InitializeGame(void)
 }
 
 // ----------------------------------------------------------------------
-//  Check for *any* key pressed (for Konami code logic)
+//  Loads the code table; the Konami code is always available
 // ----------------------------------------------------------------------
-bool IsAnyKeyPressed(void) {
-    for (int key = KEY_SPACE; key <= KEY_KP_9; key++) {
-        if (IsKeyPressed(key)) return true;
+void InitCheatCodes(void) {
+    InitSequenceMatcher(&cheatCodes);
+    AddSequenceCode(&cheatCodes, "konami", "hp_boost", KONAMI_CODE, KONAMI_CODE_LENGTH);
+    if (!LoadSequenceCodes(&cheatCodes, CODES_PATH)) {
+        BuildSequenceMatcher(&cheatCodes);
     }
-    return false;
 }
 
 // ----------------------------------------------------------------------
-//  Checks Konami code input
+//  Effects a code can trigger. Gameplay ones only apply mid-round,
+//  service ones work from any screen.
 // ----------------------------------------------------------------------
-void Upgrades(void) {
-    if (IsKeyPressed(KONAMI_CODE[konamiIndex])) {
-        konamiIndex++;
-        if (konamiIndex == KONAMI_CODE_LENGTH) {
-            player.HP += 9001;
-            konamiIndex = 0;
+void ApplyCodeAction(const char *action) {
+    bool playing = (gameFlow.current == GAME_PLAYING);
+
+    if (strcmp(action, "hp_boost") == 0) {
+        if (playing) player.HP += 9001;
+    }
+    else if (strcmp(action, "extra_balls") == 0) {
+        if (playing) SpawnFourBalls();
+    }
+    else if (strcmp(action, "skip_level") == 0) {
+        if (playing) {
+            for (int i = 0; i < currentLevel.blockCount; i++) {
+                if (!currentLevel.blocks[i].active) continue;
+                blockDigest ^= BlockHashTerm(i);
+                currentLevel.blocks[i].active = false;
+                blockDigest ^= BlockHashTerm(i);
+            }
+            liveBlocks = 0;
         }
     }
-    else if (IsAnyKeyPressed()) {
-        konamiIndex = 0;
+    else if (strcmp(action, "reset_highscore") == 0) {
+        player.highscore = 0.0f;
+        dataLoader(false);
+    }
+    else {
+        TraceLog(LOG_WARNING, "CODES: Unknown action '%s'", action);
+    }
+}
+
+// ----------------------------------------------------------------------
+//  Feeds this frame's key events to the code matcher
+// ----------------------------------------------------------------------
+void Upgrades(void) {
+    const InputFrame *input = GetInputFrame();
+    for (int i = 0; i < input->eventCount; i++) {
+        uint64_t matched = FeedSequenceKey(&cheatCodes, input->events[i].key);
+        for (int code = 0; matched != 0; code++, matched >>= 1) {
+            if (matched & 1) ApplyCodeAction(cheatCodes.codes[code].action);
+        }
     }
 }
 
@@ -271,127 +624,550 @@ void Upgrades(void) {
 // ----------------------------------------------------------------------
 void SpawnFourBallsIfNeeded(void) {
     if (!fourBallsSpawned && player.currentScore >= 4000.0f) {
-        for (int i = 0; i < 4; i++) {
-            extraBallsActive[i] = true;
-            extraBallX[i]      = ballPos.x;
-            extraBallY[i]      = ballPos.y;
+        SpawnFourBalls();
+        fourBallsSpawned = true;
+    }
+}
+
+void SpawnFourBalls(void) {
+    // From the main ball, or from just above the paddle while it waits for launch
+    Vector2 origin;
+    Vector2 *mainPos = GetComponent(&world, mainBall, COMP_POSITION);
+    if (mainPos) {
+        origin = *mainPos;
+    }
+    else {
+        Vector2 *paddlePos = GetComponent(&world, paddle, COMP_POSITION);
+        if (!paddlePos) return;
+        origin = (Vector2){ paddlePos->x + PADDLE_WIDTH / 2, paddlePos->y - BALL_RADIUS * 2 };
+    }
+
+    for (int i = 0; i < 4; i++) {
+        int degrees = RandomValue(&ballRandom, 0, 359);
+        float angle = degrees * DEG2RAD;
+        Vector2 speed = fixedPhysics ? FixedAngleVelocity(degrees, BALL_SPEED)
+                                     : (Vector2){ cosf(angle) * BALL_SPEED, sinf(angle) * BALL_SPEED };
+        SpawnBall(origin, speed, YELLOW, false);
+    }
+}
+
+// ----------------------------------------------------------------------
+//  Entity spawning
+// ----------------------------------------------------------------------
+void SpawnPaddle(void) {
+    paddle = CreateEntity(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_PADDLE));
+
+    Vector2 *position = GetComponent(&world, paddle, COMP_POSITION);
+    PaddleComponent *shape = GetComponent(&world, paddle, COMP_PADDLE);
+    *position = (Vector2){ SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT - 150.0f };
+    shape->size  = (Vector2){ PADDLE_WIDTH, PADDLE_HEIGHT };
+    shape->speed = movementSpeed;
+}
+
+EcsEntity SpawnBall(Vector2 position, Vector2 speed, Color color, bool isMain) {
+    EcsEntity entity = CreateEntity(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_VELOCITY) |
+                                            ECS_MASK(COMP_COLLIDER) | ECS_MASK(COMP_BALL));
+    if (entity == ECS_INVALID_ENTITY) return entity;
+
+    *(Vector2 *)GetComponent(&world, entity, COMP_POSITION) = position;
+    *(Vector2 *)GetComponent(&world, entity, COMP_VELOCITY) = speed;
+    ((ColliderComponent *)GetComponent(&world, entity, COMP_COLLIDER))->radius = BALL_RADIUS;
+
+    BallComponent *ball = GetComponent(&world, entity, COMP_BALL);
+    ball->color  = color;
+    ball->isMain = isMain;
+    return entity;
+}
+
+void SpawnPickup(Vector2 position, PowerUpKind kind) {
+    if (CountEntities(&world, ECS_MASK(COMP_PICKUP)) >= MAX_PICKUPS) return;
+
+    EcsEntity entity = CreateEntity(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_VELOCITY) |
+                                            ECS_MASK(COMP_COLLIDER) | ECS_MASK(COMP_PICKUP));
+    if (entity == ECS_INVALID_ENTITY) return;
+
+    *(Vector2 *)GetComponent(&world, entity, COMP_POSITION) = position;
+    *(Vector2 *)GetComponent(&world, entity, COMP_VELOCITY) = (Vector2){ 0.0f, PICKUP_FALL_SPEED };
+    ((ColliderComponent *)GetComponent(&world, entity, COMP_COLLIDER))->radius = PICKUP_RADIUS;
+    ((PickupComponent *)GetComponent(&world, entity, COMP_PICKUP))->kind = kind;
+}
 
-            float angle = GetRandomValue(0, 359) * DEG2RAD;
-            extraBallSpeedX[i] = cosf(angle) * BALL_SPEED;
-            extraBallSpeedY[i] = sinf(angle) * BALL_SPEED;
+void ClearBalls(void) {
+    EcsIter it = QueryEntities(&world, ECS_MASK(COMP_BALL));
+    while (NextChunk(&it)) {
+        const EcsEntity *entities = IterEntities(&it);
+        for (int i = 0; i < it.count; i++) DeferDestroyEntity(&world, entities[i]);
+    }
+    FlushDestroyedEntities(&world);
+}
+
+// ----------------------------------------------------------------------
+//  Systems: each walks the dense component arrays of whatever entities
+//  carry the components it needs, so new entity kinds cost them nothing
+// ----------------------------------------------------------------------
+void PaddleControlSystem(float dt) {
+    float direction = 0.0f;
+    if (IsActionDown(ACTION_MOVE_LEFT))       direction = -1.0f;
+    else if (IsActionDown(ACTION_MOVE_RIGHT)) direction =  1.0f;
+    if (direction == 0.0f) return;
+    int32_t fixedStep = ToFixedTime(dt);
+
+    EcsIter it = QueryEntities(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_PADDLE));
+    while (NextChunk(&it)) {
+        Vector2 *position      = IterColumn(&it, COMP_POSITION);
+        PaddleComponent *shape = IterColumn(&it, COMP_PADDLE);
+        for (int i = 0; i < it.count; i++) {
+            bool canMove = (direction < 0) ? position[i].x > 0 : position[i].x + shape[i].size.x < SCREEN_WIDTH;
+            if (!canMove) continue;
+            if (fixedPhysics) position[i].x = FixedAdvance(position[i].x, direction * shape[i].speed, fixedStep);
+            else              position[i].x += direction * shape[i].speed * dt;
+        }
+    }
+}
+
+// Moves every ball, bounces it off the walls and drops the ones that fall out
+void BallMovementSystem(float dt) {
+    float step = dt * ballSpeedScale;
+    ballClock += step;
+    int32_t fixedStep = (int32_t)(((int64_t)ToFixedTime(dt) * ToFixedTime(ballSpeedScale)) >> FIXED_TIME_SHIFT);
+
+    EcsIter it = QueryEntities(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_VELOCITY) |
+                                       ECS_MASK(COMP_COLLIDER) | ECS_MASK(COMP_BALL));
+    while (NextChunk(&it)) {
+        Vector2 *position           = IterColumn(&it, COMP_POSITION);
+        Vector2 *velocity           = IterColumn(&it, COMP_VELOCITY);
+        ColliderComponent *collider = IterColumn(&it, COMP_COLLIDER);
+        const EcsEntity *entities   = IterEntities(&it);
+
+        for (int i = 0; i < it.count; i++) {
+            float radius = collider[i].radius;
+            bool fellOut;
+            if (fixedPhysics) {
+                fellOut = FixedMoveBall(&position[i], &velocity[i], radius, SCREEN_WIDTH, SCREEN_HEIGHT, fixedStep);
+            }
+            else {
+                position[i].x += velocity[i].x * step;
+                position[i].y += velocity[i].y * step;
+
+                // Check left/right walls (only while heading into them, or a
+                // ball pushed past the edge flips every frame and sticks there)
+                if ((position[i].x - radius <= 0 && velocity[i].x < 0) ||
+                    (position[i].x + radius >= SCREEN_WIDTH && velocity[i].x > 0)) {
+                    velocity[i].x *= -1.0f;
+                }
+                // Check top
+                if (position[i].y - radius <= 0 && velocity[i].y < 0) {
+                    velocity[i].y *= -1.0f;
+                }
+                fellOut = position[i].y + radius >= SCREEN_HEIGHT;
+            }
+            // Check bottom
+            if (fellOut) {
+                DeferDestroyEntity(&world, entities[i]);
+                player.HP -= 1;
+            }
         }
-        fourBallsSpawned = true;
     }
+    FlushDestroyedEntities(&world);
+}
+
+// Pickups fall straight down and are gone once they leave the screen
+void PickupFallSystem(float dt) {
+    int32_t fixedStep = ToFixedTime(dt);
+    EcsIter it = QueryEntities(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_VELOCITY) |
+                                       ECS_MASK(COMP_COLLIDER) | ECS_MASK(COMP_PICKUP));
+    while (NextChunk(&it)) {
+        Vector2 *position           = IterColumn(&it, COMP_POSITION);
+        Vector2 *velocity           = IterColumn(&it, COMP_VELOCITY);
+        ColliderComponent *collider = IterColumn(&it, COMP_COLLIDER);
+        const EcsEntity *entities   = IterEntities(&it);
+
+        for (int i = 0; i < it.count; i++) {
+            if (fixedPhysics) {
+                position[i].x = FixedAdvance(position[i].x, velocity[i].x, fixedStep);
+                position[i].y = FixedAdvance(position[i].y, velocity[i].y, fixedStep);
+            }
+            else {
+                position[i].x += velocity[i].x * dt;
+                position[i].y += velocity[i].y * dt;
+            }
+            if (position[i].y - collider[i].radius > SCREEN_HEIGHT) {
+                DeferDestroyEntity(&world, entities[i]);
+            }
+        }
+    }
+    FlushDestroyedEntities(&world);
 }
 
 // ----------------------------------------------------------------------
-//  Main gameplay logic
+//  One broadphase for everything that can touch the paddle: a bounds
+//  reject first, the circle test only for what survives it. Balls bounce,
+//  pickups are collected once the pass is over.
 // ----------------------------------------------------------------------
-void UpdateGame(void) {
-    float dt = GetFrameTime();
+void PaddleContactSystem(void) {
+    Vector2 *paddlePos     = GetComponent(&world, paddle, COMP_POSITION);
+    PaddleComponent *shape = GetComponent(&world, paddle, COMP_PADDLE);
+    if (!paddlePos) return;
+
+    Rectangle paddleRect = { paddlePos->x, paddlePos->y, shape->size.x, shape->size.y };
+    PowerUpKind collected[MAX_PICKUPS];
+    int collectedCount = 0;
+
+    EcsIter it = QueryEntities(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_COLLIDER));
+    while (NextChunk(&it)) {
+        Vector2 *position           = IterColumn(&it, COMP_POSITION);
+        ColliderComponent *collider = IterColumn(&it, COMP_COLLIDER);
+        Vector2 *velocity           = IterColumn(&it, COMP_VELOCITY);
+        PickupComponent *pickup     = IterColumn(&it, COMP_PICKUP);
+        bool isBall                 = IterColumn(&it, COMP_BALL) != NULL;
+        const EcsEntity *entities   = IterEntities(&it);
+
+        for (int i = 0; i < it.count; i++) {
+            float radius = collider[i].radius;
+            if (position[i].y + radius < paddleRect.y ||
+                position[i].y - radius > paddleRect.y + paddleRect.height ||
+                position[i].x + radius < paddleRect.x ||
+                position[i].x - radius > paddleRect.x + paddleRect.width) {
+                continue;
+            }
+            bool touching = fixedPhysics ? FixedCircleTouchesRect(ToFixedCircle(position[i], radius), paddleRect)
+                                         : CheckCollisionCircleRec(position[i], radius, paddleRect);
+            if (!touching) continue;
+
+            if (isBall && velocity) {
+                InvalidateTrajectory(&trajectories, ECS_ENTITY_SLOT(entities[i]));
+                if (fixedPhysics) {
+                    FixedPaddleBounce(position[i], &velocity[i], paddleRect, BALL_SPEED);
+                }
+                else {
+                    velocity[i].y = -BALL_SPEED;
+                    float hitPos  = (position[i].x - paddleRect.x) / paddleRect.width;
+                    velocity[i].x = (hitPos - 0.5f) * BALL_SPEED * 2.0f;
+                }
+            }
+            else if (pickup && collectedCount < MAX_PICKUPS) {
+                collected[collectedCount++] = pickup[i].kind;
+                DeferDestroyEntity(&world, entities[i]);
+            }
+        }
+    }
+    FlushDestroyedEntities(&world);
 
-    // Launch the main ball if space is pressed and ball is not active
-    if (IsKeyPressed(KEY_SPACE) && !ball_active && isAlive) {
-        ball_active   = true;
-        ballPos.x     = playerX + (SCREEN_WIDTH / 50);
-        ballPos.y     = playerY;
-        ballSpeed.y   = -BALL_SPEED;
-        ballSpeed.x   = (GetRandomValue(0, 1) == 0) ? -BALL_SPEED / 2 : BALL_SPEED / 2;
+    // Multiball spawns entities, so effects wait until iteration is done
+    for (int i = 0; i < collectedCount; i++) ApplyPowerUp(collected[i]);
+}
+
+// At most one block hit per ball per frame
+void BlockCollisionSystem(void) {
+    EcsIter it = QueryEntities(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_VELOCITY) |
+                                       ECS_MASK(COMP_COLLIDER) | ECS_MASK(COMP_BALL));
+    while (NextChunk(&it)) {
+        Vector2 *position           = IterColumn(&it, COMP_POSITION);
+        Vector2 *velocity           = IterColumn(&it, COMP_VELOCITY);
+        ColliderComponent *collider = IterColumn(&it, COMP_COLLIDER);
+        const EcsEntity *entities   = IterEntities(&it);
+
+        for (int i = 0; i < it.count; i++) {
+            if (CheckBlockCollision(&position[i].x, &position[i].y, collider[i].radius,
+                                    &velocity[i].x, &velocity[i].y)) {
+                InvalidateTrajectory(&trajectories, ECS_ENTITY_SLOT(entities[i]));
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------
+//  Power-up effects
+// ----------------------------------------------------------------------
+void ApplyPowerUp(PowerUpKind kind) {
+    if (kind == POWERUP_MULTIBALL) {
+        SpawnFourBalls();
+        return;
+    }
+    // Catching another refreshes it
+    CancelTimer(&timers, powerUpTimers[kind]);
+    powerUpTimers[kind] = ScheduleTimer(&timers, (uint64_t)(POWERUPS[kind].duration * TICKS_PER_SECOND),
+                                        TIMER_POWERUP_EXPIRE, kind);
+    powerUpActive[kind] = true;
+}
+
+bool IsPowerUpActive(PowerUpKind kind) {
+    return powerUpActive[kind];
+}
+
+// Applies what is active to paddle and balls
+void PowerUpEffectSystem(void) {
+    ballSpeedScale = IsPowerUpActive(POWERUP_SLOW_BALL) ? 0.6f : 1.0f;
+
+    Vector2 *paddlePos     = GetComponent(&world, paddle, COMP_POSITION);
+    PaddleComponent *shape = GetComponent(&world, paddle, COMP_PADDLE);
+    if (!paddlePos) return;
+
+    // Grow and shrink around the centre, then keep it on screen
+    float width = IsPowerUpActive(POWERUP_WIDE_PADDLE) ? PADDLE_WIDTH * 1.5f : PADDLE_WIDTH;
+    if (width != shape->size.x) {
+        paddlePos->x += (shape->size.x - width) / 2;
+        shape->size.x = width;
+        if (paddlePos->x < 0) paddlePos->x = 0;
+        if (paddlePos->x + width > SCREEN_WIDTH) paddlePos->x = SCREEN_WIDTH - width;
+    }
+}
+
+// ----------------------------------------------------------------------
+//  Timers that came due this tick
+// ----------------------------------------------------------------------
+void FireGameTimer(void *userData, int kind, int arg) {
+    (void)userData;
+    switch (kind) {
+        case TIMER_POWERUP_EXPIRE:
+            powerUpActive[arg] = false;
+            powerUpTimers[arg] = TIMER_INVALID;
+            break;
+        case TIMER_BLOCK_RESPAWN:
+            RespawnBlock(arg);
+            break;
+    }
+}
+
+// ----------------------------------------------------------------------
+//  While the laser is armed and fire is held, both paddle ends shoot.
+//  Shots already in the air keep flying after it runs out.
+// ----------------------------------------------------------------------
+void LaserSystem(float dt) {
+    Vector2 *paddlePos     = GetComponent(&world, paddle, COMP_POSITION);
+    PaddleComponent *shape = GetComponent(&world, paddle, COMP_PADDLE);
+
+    laserCooldown -= dt;
+    if (paddlePos && IsPowerUpActive(POWERUP_LASER) && IsActionDown(ACTION_FIRE) && laserCooldown <= 0.0f) {
+        FireProjectile(&lasers, paddlePos->x + 3.0f, paddlePos->y - PROJECTILE_LENGTH);
+        FireProjectile(&lasers, paddlePos->x + shape->size.x - 3.0f, paddlePos->y - PROJECTILE_LENGTH);
+        laserCooldown = LASER_FIRE_INTERVAL;
     }
 
-    // Main ball movement
-    if (ball_active) {
-        // Update main ball with Vector2 + dt
-        ballPos.x += ballSpeed.x * dt;
-        ballPos.y += ballSpeed.y * dt;
+    int hits[MAX_LASER_HITS];
+    int hitCount = UpdateProjectiles(&lasers, &blockColumns, currentLevel.blocks, dt, fixedPhysics,
+                                     hits, MAX_LASER_HITS);
+    for (int i = 0; i < hitCount; i++) DamageBlock(hits[i]);
+}
+
+static void ExplosionDamage(void *userData, int index) {
+    (void)userData;
+    DamageBlock(index);
+}
 
-        // Check left/right walls
-        if (ballPos.x - BALL_RADIUS <= 0 || ballPos.x + BALL_RADIUS >= SCREEN_WIDTH) {
-            ballSpeed.x *= -1.0f;
+void ChainReactionSystem(void) {
+    StepChainReaction(&chain, &currentLevel, &blockColumns, CHAIN_REACTION_BUDGET, ExplosionDamage, NULL);
+}
+
+// Chips on a hit, the whole block bursts apart when destroyed and may drop a pickup
+void BlockHitSystem(void) {
+    for (int i = 0; i < blockHitCount; i++) {
+        const Block *block = &currentLevel.blocks[blockHits[i].index];
+        if (!blockHits[i].destroyed) {
+            EmitParticleBurst(&particles, block->rect, block->color, 8, 250.0f, 0.4f);
+            continue;
         }
-        // Check top
-        if (ballPos.y - BALL_RADIUS <= 0) {
-            ballSpeed.y *= -1.0f;
+
+        EmitParticleBurst(&particles, block->rect, block->color, 48, 400.0f, 0.8f);
+        if (block->type == BLOCK_EXPLOSIVE) {
+            EmitParticleBurst(&particles, block->rect, YELLOW, 64, 700.0f, 0.6f);
         }
-        // Check bottom
-        if (ballPos.y + BALL_RADIUS >= SCREEN_HEIGHT) {
-            ball_active = false;
-            player.HP -= 1;
+        if (RandomValue(&pickupRandom, 1, PICKUP_DROP_CHANCE) == 1) {
+            Vector2 centre = { block->rect.x + block->rect.width / 2, block->rect.y + block->rect.height / 2 };
+            SpawnPickup(centre, (PowerUpKind)RandomValue(&pickupRandom, 0, POWERUP_KIND_COUNT - 1));
         }
+    }
+    blockHitCount = 0;
+}
 
-        // Paddle collision
-        Rectangle playerRect = { playerX, playerY, SCREEN_WIDTH / 20.0f, SCREEN_HEIGHT / 50.0f };
-        if (CheckCollisionCircleRec((Vector2){ ballPos.x, ballPos.y }, BALL_RADIUS, playerRect)) {
-            ballSpeed.y = -BALL_SPEED;
-            float hitPos = (ballPos.x - playerX) / (SCREEN_WIDTH / 20.0f);
-            ballSpeed.x  = (hitPos - 0.5f) * BALL_SPEED * 2.0f;
+void DrawPaddleSystem(void) {
+    EcsIter it = QueryEntities(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_PADDLE));
+    while (NextChunk(&it)) {
+        Vector2 *position      = IterColumn(&it, COMP_POSITION);
+        PaddleComponent *shape = IterColumn(&it, COMP_PADDLE);
+        for (int i = 0; i < it.count; i++) {
+            DrawRectangle((int)position[i].x, (int)position[i].y, (int)shape[i].size.x, (int)shape[i].size.y, WHITE);
+
+            // Laser armed: emitters on both ends
+            if (IsPowerUpActive(POWERUP_LASER)) {
+                DrawRectangle((int)position[i].x, (int)position[i].y - 6, 6, 6, RED);
+                DrawRectangle((int)(position[i].x + shape[i].size.x) - 6, (int)position[i].y - 6, 6, 6, RED);
+            }
         }
+    }
+}
 
-        // Check block collisions
-        CheckBlockCollision(&ballPos.x, &ballPos.y, BALL_RADIUS, &ballSpeed.x, &ballSpeed.y);
+void DrawBallsSystem(void) {
+    EcsIter it = QueryEntities(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_COLLIDER) | ECS_MASK(COMP_BALL));
+    while (NextChunk(&it)) {
+        Vector2 *position           = IterColumn(&it, COMP_POSITION);
+        ColliderComponent *collider = IterColumn(&it, COMP_COLLIDER);
+        BallComponent *ball         = IterColumn(&it, COMP_BALL);
+        for (int i = 0; i < it.count; i++) {
+            DrawCircle((int)position[i].x, (int)position[i].y, collider[i].radius, ball[i].color);
+        }
     }
+}
 
-    SpawnFourBallsIfNeeded();
+void DrawPickupsSystem(void) {
+    EcsIter it = QueryEntities(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_COLLIDER) | ECS_MASK(COMP_PICKUP));
+    while (NextChunk(&it)) {
+        Vector2 *position           = IterColumn(&it, COMP_POSITION);
+        ColliderComponent *collider = IterColumn(&it, COMP_COLLIDER);
+        PickupComponent *pickup     = IterColumn(&it, COMP_PICKUP);
+        for (int i = 0; i < it.count; i++) {
+            const PowerUpDesc *desc = &POWERUPS[pickup[i].kind];
+            DrawCircle((int)position[i].x, (int)position[i].y, collider[i].radius, desc->color);
+            DrawText(desc->label, (int)position[i].x - 5, (int)position[i].y - 8, 18, BLACK);
+        }
+    }
+}
 
-    // Extra balls logic (unchanged)
-    for (int i = 0; i < 4; i++) {
-        if (extraBallsActive[i]) {
-            extraBallX[i] += extraBallSpeedX[i];
-            extraBallY[i] += extraBallSpeedY[i];
+// ----------------------------------------------------------------------
+//  Autopilot: finds the ball that reaches the paddle first and holds left
+//  or right until the paddle is where it needs to be. PaddleControlSystem
+//  then moves it exactly as it would for a player.
+// ----------------------------------------------------------------------
+void AutopilotSystem(float dt) {
+    Vector2 *paddlePos     = GetComponent(&world, paddle, COMP_POSITION);
+    PaddleComponent *shape = GetComponent(&world, paddle, COMP_PADDLE);
+    if (!paddlePos) return;
+
+    InjectAction(ACTION_MOVE_LEFT, false, false);
+    InjectAction(ACTION_MOVE_RIGHT, false, false);
+    if (!IsEntityAlive(&world, mainBall)) {
+        InjectAction(ACTION_LAUNCH, false, true);
+        return;
+    }
 
-            // bounce off left/right walls
-            if (extraBallX[i] - BALL_RADIUS <= 0 || extraBallX[i] + BALL_RADIUS >= SCREEN_WIDTH) {
-                extraBallSpeedX[i] *= -1.0f;
+    float bestTime = 0.0f, bestX = 0.0f;
+    bool found = false;
+    EcsIter it = QueryEntities(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_VELOCITY) |
+                                       ECS_MASK(COMP_COLLIDER) | ECS_MASK(COMP_BALL));
+    while (NextChunk(&it)) {
+        Vector2 *position           = IterColumn(&it, COMP_POSITION);
+        Vector2 *velocity           = IterColumn(&it, COMP_VELOCITY);
+        ColliderComponent *collider = IterColumn(&it, COMP_COLLIDER);
+        const EcsEntity *entities   = IterEntities(&it);
+
+        for (int i = 0; i < it.count; i++) {
+            float lineY = paddlePos->y - collider[i].radius;
+            if (position[i].y > lineY) continue;    // already past the paddle
+
+            // Blocks in the way come from the cached path; past its last
+            // bounce, or without a cache, walls only
+            float crossX, time;
+            const TrajectoryPath *path = NULL;
+            if (trajectories.capacity > 0) {
+                path = UpdateTrajectory(&trajectories, ECS_ENTITY_SLOT(entities[i]), entities[i], &currentLevel,
+                                        position[i], velocity[i], collider[i].radius, ballClock);
             }
-            // bounce off top
-            if (extraBallY[i] - BALL_RADIUS <= 0) {
-                extraBallSpeedY[i] *= -1.0f;
+            if (path && path->reachesLine) {
+                crossX = path->points[path->pointCount - 1].x;
+                time   = (float)(path->startTime + path->times[path->pointCount - 1] - ballClock);
             }
-            // hits bottom
-            if (extraBallY[i] + BALL_RADIUS >= SCREEN_HEIGHT) {
-                extraBallsActive[i] = false;
-                player.HP -= 1;
+            else if (!PredictBallCrossing(position[i], velocity[i], collider[i].radius, lineY, SCREEN_WIDTH,
+                                          &crossX, &time)) {
+                continue;
             }
-
-            // Paddle collision
-            Rectangle playerRect = { playerX, playerY, SCREEN_WIDTH / 20.0f, SCREEN_HEIGHT / 50.0f };
-            if (CheckCollisionCircleRec((Vector2){extraBallX[i], extraBallY[i]}, BALL_RADIUS, playerRect)) {
-                extraBallSpeedY[i] = -BALL_SPEED;
-                float hitPos = (extraBallX[i] - playerX) / (SCREEN_WIDTH / 20.0f);
-                extraBallSpeedX[i] = (hitPos - 0.5f) * BALL_SPEED * 2.0f;
+            if (!found || time < bestTime) {
+                bestTime = time;
+                bestX    = crossX;
+                found    = true;
             }
-
-            // Check block collisions
-            CheckBlockCollision(&extraBallX[i], &extraBallY[i], BALL_RADIUS,
-                                &extraBallSpeedX[i], &extraBallSpeedY[i]);
         }
     }
+    if (!found) return;
+
+    // Off centre when just catching, so the return never goes straight up
+    float goal = bestX - shape->size.x * 0.4f;
+    if (autopilot == AUTOPILOT_AIM) {
+        int target = PickAutopilotTarget(bestX);
+        if (target >= 0) {
+            Rectangle rect = currentLevel.blocks[target].rect;
+            Vector2 aim    = { rect.x + rect.width / 2, rect.y + rect.height };
+            goal = AimPaddleX(bestX, paddlePos->y - BALL_RADIUS, shape->size.x, BALL_SPEED, aim);
+        }
+    }
+
+    float deadband = shape->speed * dt;
+    if (paddlePos->x > goal + deadband)      InjectAction(ACTION_MOVE_LEFT, true, false);
+    else if (paddlePos->x < goal - deadband) InjectAction(ACTION_MOVE_RIGHT, true, false);
+}
 
-    // Paddle movement with dt
-    if (IsKeyDown(KEY_A) && playerX > 0) {
-        playerX -= movementSpeed * dt;
+// Keeps the current target while it stands, otherwise the lowest block
+// left, nearest the ball among equals. Scans only when a target goes.
+int PickAutopilotTarget(float crossX) {
+    if (autopilotTarget >= 0 && autopilotTarget < currentLevel.blockCount &&
+        currentLevel.blocks[autopilotTarget].active) {
+        return autopilotTarget;
     }
-    else if (IsKeyDown(KEY_D) && playerX + (SCREEN_WIDTH / 20) < SCREEN_WIDTH) {
-        playerX += movementSpeed * dt;
+
+    autopilotTarget = -1;
+    float bestBottom = 0.0f, bestDistance = 0.0f;
+    for (int i = 0; i < currentLevel.blockCount; i++) {
+        const Block *block = &currentLevel.blocks[i];
+        if (!block->active) continue;
+        float bottom   = block->rect.y + block->rect.height;
+        float distance = fabsf(block->rect.x + block->rect.width / 2 - crossX);
+        if (autopilotTarget < 0 || bottom > bestBottom || (bottom == bestBottom && distance < bestDistance)) {
+            autopilotTarget = i;
+            bestBottom      = bottom;
+            bestDistance    = distance;
+        }
+    }
+    return autopilotTarget;
+}
+
+// Start, restart and go on to the next level without anyone at the keys
+void AutopilotMenus(void) {
+    if (gameFlow.current == GAME_PLAYING) return;
+    menuOption = 0;
+    InjectAction(ACTION_CONFIRM, false, true);
+    InjectAction(ACTION_YES, false, true);
+}
+
+// ----------------------------------------------------------------------
+//  Main gameplay logic
+// ----------------------------------------------------------------------
+void UpdateGame(void) {
+    float dt = GetInputFrameTime();
+    QuickSaveSystem();
+    if (autopilot != AUTOPILOT_OFF) AutopilotSystem(dt);
+
+    // Launch the main ball if space is pressed and ball is not active
+    if (IsActionPressed(ACTION_LAUNCH) && !IsEntityAlive(&world, mainBall)) {
+        Vector2 *paddlePos = GetComponent(&world, paddle, COMP_POSITION);
+        Vector2 speed = { (RandomValue(&launchRandom, 0, 1) == 0) ? -BALL_SPEED / 2 : BALL_SPEED / 2, -BALL_SPEED };
+        mainBall = SpawnBall((Vector2){ paddlePos->x + (SCREEN_WIDTH / 50), paddlePos->y }, speed, WHITE, true);
     }
 
+    SpawnFourBallsIfNeeded();
+
+    simClock += dt;
+    AdvanceTimerWheel(&timers, (uint64_t)(simClock * TICKS_PER_SECOND), FireGameTimer, NULL);
+    PowerUpEffectSystem();
+    BallMovementSystem(dt);
+    PickupFallSystem(dt);
+    PaddleContactSystem();
+    BlockCollisionSystem();
+    LaserSystem(dt);
+    ChainReactionSystem();
+    BlockHitSystem();
+    UpdateParticles(&particles, dt);
+    PaddleControlSystem(dt);
+
     // Check if player is out of lives
     if (player.HP <= 0) {
         player.HP = 0;
-        isAlive = false;
-        ball_active = false;
-        for (int i = 0; i < 4; i++) {
-            extraBallsActive[i] = false;
-        }
+        ClearBalls();
+        SendStateEvent(&gameFlow, EVENT_DIED);
     }
 
-    // Check if all blocks are cleared
-    if (AllBlocksCleared() && !gameWon) {
-        gameWon = true;
-        ball_active = false;
-        for (int i = 0; i < 4; i++) {
-            extraBallsActive[i] = false;
-        }
+    // Check if all blocks are cleared (sent last, so a win beats a loss)
+    if (AllBlocksCleared()) {
+        ClearBalls();
+        SendStateEvent(&gameFlow, EVENT_CLEARED);
     }
 }
 
@@ -411,23 +1187,13 @@ void DrawGame(void) {
     DrawText(TextFormat("Lives: %.0f", player.HP),
              SCREEN_WIDTH -1700, SCREEN_HEIGHT - 100, 50, WHITE);
 
-    // Paddle
-    DrawRectangle((int)playerX, (int)playerY, SCREEN_WIDTH / 20, SCREEN_HEIGHT / 50, WHITE);
-
-    // Main ball (Vector2)
-    if (ball_active) {
-        DrawCircle((int)ballPos.x, (int)ballPos.y, BALL_RADIUS, WHITE);
-    }
-
-    // Extra balls
-    for (int i = 0; i < 4; i++) {
-        if (extraBallsActive[i]) {
-            DrawCircle((int)extraBallX[i], (int)extraBallY[i], BALL_RADIUS, YELLOW);
-        }
-    }
+    DrawPaddleSystem();
+    DrawBallsSystem();
+    DrawPickupsSystem();
 
     // Blocks
-    for (int i = 0; i < MAX_BLOCKS; i++) {
+    Block *blocks = currentLevel.blocks;
+    for (int i = 0; i < currentLevel.blockCount; i++) {
         if (blocks[i].active) {
             DrawRectangleRec(blocks[i].rect, blocks[i].color);
             DrawText(TextFormat("%d", blocks[i].health),
@@ -436,21 +1202,25 @@ void DrawGame(void) {
                      20, WHITE);
         }
     }
+
+    // Debris and shots over the blocks
+    DrawParticles(&particles);
+    DrawProjectiles(&lasers, RED);
 }
 
 // ----------------------------------------------------------------------
 //  Win Screen (if all blocks cleared)
 // ----------------------------------------------------------------------
 void WinScreen(void) {
-    if (IsKeyPressed(KEY_Y)) {
-        level.currentRows *= 2; // Doubling rows for next level
-        GameStarter();
+    if (IsActionPressed(ACTION_YES)) {
+        SendStateEvent(&gameFlow, EVENT_START); // swaps in the level PrepareNextLevel built meanwhile
     }
-    else if (IsKeyPressed(KEY_N)) {
-        CloseWindow();
+    else if (IsActionPressed(ACTION_NO)) {
+        quitRequested = true;
     }
-    levelReset();
+}
 
+void DrawWinScreen(void) {
     DrawText("YOU WIN!", SCREEN_WIDTH/2 - 150, SCREEN_HEIGHT/2, 50, GREEN);
     DrawText("GENERATE NEXT LEVEL (Y/N)", SCREEN_WIDTH/2 - 300, SCREEN_HEIGHT/2 + 60, 50, WHITE);
 }
@@ -460,40 +1230,33 @@ void WinScreen(void) {
 // ----------------------------------------------------------------------
 void GameOver(void)
 {
-    static bool initialized = false;
-    static int menuOption = 0;
-
-    if (!initialized)
-    {
-        menuOption = 0;
-        initialized = true;
-    }
-
-    if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W))
+    if (IsActionPressed(ACTION_MENU_UP))
     {
         menuOption--;
         if (menuOption < 0) menuOption = 1;
     }
-    else if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S))
+    else if (IsActionPressed(ACTION_MENU_DOWN))
     {
         menuOption++;
         if (menuOption > 1) menuOption = 0;
     }
-    if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE))
+    if (IsActionPressed(ACTION_CONFIRM))
     {
         if (menuOption == 0)
         {
             player.HP = startHP;
-            GameStarter();
-            initialized = false;
+            levelNumber = 1;
+            SendStateEvent(&gameFlow, EVENT_START);
         }
         else
         {
-            dataLoader(false);
-            CloseWindow();
+            quitRequested = true;
         }
     }
+}
 
+void DrawGameOver(void)
+{
     DrawText("GAME OVER!", SCREEN_WIDTH/2 - 150, SCREEN_HEIGHT/2 - 100, 50, RED);
 
     Color restartColor = (menuOption == 0) ? YELLOW : GRAY;
@@ -508,6 +1271,49 @@ void GameOver(void)
              SCREEN_WIDTH/2 - 150,
              SCREEN_HEIGHT/2 + 70,
              50, quitColor);
+
+    DrawLeaderboard(SCREEN_WIDTH - 500, SCREEN_HEIGHT/2 - 100);
+}
+
+// ----------------------------------------------------------------------
+//  Hands the finished round to the I/O thread for the leaderboard
+// ----------------------------------------------------------------------
+typedef struct ScoreSubmission {
+    Leaderboard *board;
+    LeaderboardEntry entry;
+} ScoreSubmission;
+
+static void InsertScoreJob(void *payload) {
+    ScoreSubmission *submission = (ScoreSubmission *)payload;
+    InsertLeaderboardEntry(submission->board, &submission->entry);
+}
+
+void SubmitScore(void) {
+    if (!leaderboard.file || player.currentScore <= 0) return;
+
+    ScoreSubmission submission = { 0 };
+    submission.board = &leaderboard;
+    memcpy(submission.entry.initials, playerInitials, sizeof(playerInitials));
+    submission.entry.score        = (uint32_t)player.currentScore;
+    submission.entry.timestamp    = (int64_t)time(NULL);
+    submission.entry.levelReached = (uint16_t)levelNumber;
+
+    PostIoJob(&ioWorker, InsertScoreJob, &submission, sizeof(submission));
+}
+
+// ----------------------------------------------------------------------
+//  Top five of the machine's board
+// ----------------------------------------------------------------------
+void DrawLeaderboard(int x, int y) {
+    LeaderboardEntry top[5];
+    int count = GetLeaderboardTop(&leaderboard, top, 5);
+
+    DrawText("TOP SCORES", x, y, 40, WHITE);
+    for (int i = 0; i < count; i++) {
+        DrawText(TextFormat("%d. %.3s %6u  L%u", i + 1, top[i].initials,
+                            (unsigned)top[i].score, (unsigned)top[i].levelReached),
+                 x, y + 50 + i * 40, 30, GRAY);
+    }
 }
 
 // ----------------------------------------------------------------------
@@ -522,70 +1328,572 @@ void levelReset(void) {
 // ----------------------------------------------------------------------
 //  Manages saving and loading user highscore data
 // ----------------------------------------------------------------------
+static void SaveHighscoreJob(void *payload) {
+    (void)payload;
+    // Cleared before the read: a save posted after this sees no job pending
+    // and queues its own, which runs after this one on the same thread
+    atomic_store(&highscoreSavePosted, false);
+    uint32_t bits = atomic_load(&pendingHighscore);
+    float highscore;
+    memcpy(&highscore, &bits, sizeof(highscore));
+    SaveHighscore(SAVE_FILE_PATH, highscore);
+}
+
 void dataLoader(bool load) {
     if (load) {
-        FILE *file = fopen("highscore.txt", "r");
-        if (file) {
-            float storedHighscore = 0.0f;
-            if (fscanf(file, "%f", &storedHighscore) == 1) {
-                player.highscore = storedHighscore;
+        LoadHighscore(SAVE_FILE_PATH, &player.highscore);
+        return;
+    }
+
+    uint32_t bits;
+    memcpy(&bits, &player.highscore, sizeof(bits));
+    atomic_store(&pendingHighscore, bits);
+
+    // Inline only with no I/O thread to race against
+    if (!ioWorker.running) {
+        SaveHighscore(SAVE_FILE_PATH, player.highscore);
+        atomic_store(&highscoreSaveMissed, false);
+        return;
+    }
+    if (atomic_exchange(&highscoreSavePosted, true)) return;    // the queued job takes the new value
+
+    if (PostIoJob(&ioWorker, SaveHighscoreJob, NULL, 0)) {
+        atomic_store(&highscoreSaveMissed, false);
+    }
+    else {
+        atomic_store(&highscoreSavePosted, false);
+        atomic_store(&highscoreSaveMissed, true);
+        TraceLog(LOG_WARNING, "SAVE: I/O queue full, highscore saved later");
+    }
+}
+
+// ----------------------------------------------------------------------
+//  A directory argument is a level pack, anything else a single level
+// ----------------------------------------------------------------------
+void LoadLevelArgument(const char *path) {
+    if (!DirectoryExists(path)) {
+        levelPath = path;
+        return;
+    }
+
+    JobPool pool;
+    InitJobPool(&pool, -1);
+    double start = NowSeconds();
+    if (LoadLevelPack(path, &pool, &levelPack)) {
+        TraceLog(LOG_INFO, "LEVEL: Pack %s: %d levels (%d rejected) in %.1f ms",
+                 path, levelPack.count, levelPack.rejected, (NowSeconds() - start) * 1000.0);
+    }
+    else {
+        TraceLog(LOG_WARNING, "LEVEL: No valid levels in %s", path);
+    }
+    ShutdownJobPool(&pool);
+}
+
+// ----------------------------------------------------------------------
+//  World state hash: everything a replayed frame has to reproduce. Menus,
+//  particles and the high score table are left out; they never feed back
+//  into play.
+//
+//  Blocks go in as blockDigest, which the code that changes a block keeps
+//  up to date, so a frame costs the same on a 40x40 level as on a 2x14
+//  one. Pending timers go in the same way, as the digest the wheel keeps
+//  as they are scheduled, cancelled and fired.
+// ----------------------------------------------------------------------
+
+// One block's share of blockDigest: index, health and whether it is active
+uint32_t BlockHashTerm(int index) {
+    const Block *block = &currentLevel.blocks[index];
+    int32_t state[2] = { block->health, block->active };
+    return Hash32((uint32_t)index, state, sizeof(state));
+}
+
+uint32_t HashWorldState(void) {
+    HashState hash;
+    BeginHash(&hash, 0);
+
+    int32_t flow[2] = { gameFlow.current, gameFlow.pendingEvent };
+    float playerState[2] = { player.HP, player.currentScore };
+    double clocks[2] = { simClock, ballClock };
+    UpdateHash(&hash, flow, sizeof(flow));
+    UpdateHash(&hash, playerState, sizeof(playerState));
+    UpdateHash(&hash, clocks, sizeof(clocks));
+    UpdateHash(&hash, &launchRandom, sizeof(launchRandom));
+    UpdateHash(&hash, &ballRandom, sizeof(ballRandom));
+    UpdateHash(&hash, &pickupRandom, sizeof(pickupRandom));
+    UpdateHash(&hash, powerUpActive, sizeof(powerUpActive));
+    UpdateHash(&hash, &ballSpeedScale, sizeof(ballSpeedScale));
+
+    UpdateHash(&hash, &blockDigest, sizeof(blockDigest));
+
+    UpdateHash(&hash, &timers.now, sizeof(timers.now));
+    UpdateHash(&hash, &timers.digest, sizeof(timers.digest));
+
+    // Chain reaction queue in the order it will go off
+    for (int i = 0, at = chain.head; i < chain.queued; i++, at = (at + 1) % chain.blockCount) {
+        UpdateHash(&hash, &chain.queue[at], sizeof(int));
+    }
+
+    // Paddle, balls and pickups, in storage order. Not their handles: a
+    // restored snapshot recreates the same entities under new ones.
+    EcsIter it = QueryEntities(&world, ECS_MASK(COMP_POSITION));
+    while (NextChunk(&it)) {
+        const Vector2 *velocity = IterColumn(&it, COMP_VELOCITY);
+        const PaddleComponent *shape = IterColumn(&it, COMP_PADDLE);
+        UpdateHash(&hash, IterColumn(&it, COMP_POSITION), sizeof(Vector2) * it.count);
+        if (velocity) UpdateHash(&hash, velocity, sizeof(Vector2) * it.count);
+        if (shape)    UpdateHash(&hash, shape, sizeof(PaddleComponent) * it.count);
+    }
+
+    UpdateHash(&hash, lasers.x, sizeof(float) * lasers.count);
+    UpdateHash(&hash, lasers.y, sizeof(float) * lasers.count);
+    return FinishHash(&hash);
+}
+
+// Records this frame's hash, or checks it against the recorded one
+void CheckStateHash(void) {
+    uint32_t hash = HashWorldState();
+    uint32_t recorded;
+    tickNumber++;
+    RecordStateHash(hash);
+
+    if (!GetRecordedStateHash(&recorded)) return;
+    checkedTicks++;
+    if (recorded == hash || divergedTick != 0) return;
+
+    divergedTick = tickNumber;
+    TraceLog(LOG_WARNING, "REPLAY: State diverged at tick %u (recorded %08x, got %08x)", tickNumber, recorded, hash);
+    if (checkReplay) replayCheckFailed = true;
+}
+
+// ----------------------------------------------------------------------
+//  Snapshots: a round in progress packed into one buffer, for quick save,
+//  rewind and rollback
+//
+//  The level, column index and pools belong to the round, so a snapshot
+//  only goes back into the round it was taken in. Blocks keep only what
+//  play changes (health, a bit for active), entities go column by column
+//  straight out of the ECS chunks. Restoring recreates the entities under
+//  new handles, which leaves every cached ball path stale: the autopilot
+//  predicts afresh and may steer a little differently than it would have.
+//  Particles are cosmetic and left alone.
+//
+//  A load checks the header and saved timers against the round before
+//  touching anything.
+//  Should the world still run out of entities partway, the balls and
+//  pickups are dropped again and the round goes on as after a lost ball.
+//
+//  Layout: header, timers, block health (int32), active bits, paddle, balls
+//  (positions, velocities, radii, colours), pickups (positions,
+//  velocities, radii, kinds), laser x, laser y, chain reaction queue.
+// ----------------------------------------------------------------------
+#define SNAPSHOT_MAGIC "BKSS"
+
+typedef struct GameSnapshotHeader {
+    double simClock;
+    double ballClock;
+    RandomStream random[3];         // launch, balls, pickups
+    uint64_t timerNow;
+    char magic[4];
+    uint32_t roundNumber;
+    int32_t blockCount;
+    int32_t autopilotTarget;
+    float hp;
+    float score;
+    float ballSpeedScale;
+    float laserCooldown;
+    uint16_t timerCount;
+    uint16_t ballCount;
+    uint16_t pickupCount;
+    uint16_t laserCount;
+    uint16_t chainCount;
+    int16_t mainBall;               // index among the balls, -1 while waiting for launch
+    int8_t pendingEvent;
+    uint8_t powerUps;               // bit per PowerUpKind
+    uint8_t fourBallsSpawned;
+    uint8_t reserved;
+} GameSnapshotHeader;
+
+typedef char GameSnapshotHeaderCheck[(sizeof(GameSnapshotHeader) == 120) ? 1 : -1];
+
+#define SNAPSHOT_BALL_BYTES   (2 * sizeof(Vector2) + sizeof(float) + sizeof(Color))
+#define SNAPSHOT_PICKUP_BYTES (2 * sizeof(Vector2) + sizeof(float) + 1)
+#define SNAPSHOT_PADDLE_BYTES (sizeof(Vector2) + sizeof(PaddleComponent))
+
+static size_t SnapshotSize(const GameSnapshotHeader *header) {
+    return sizeof(GameSnapshotHeader) + sizeof(TimerRecord) * header->timerCount +
+           sizeof(int32_t) * (size_t)header->blockCount + ((size_t)header->blockCount + 7) / 8 +
+           SNAPSHOT_PADDLE_BYTES + SNAPSHOT_BALL_BYTES * header->ballCount +
+           SNAPSHOT_PICKUP_BYTES * header->pickupCount + 2 * sizeof(float) * header->laserCount +
+           sizeof(int32_t) * header->chainCount;
+}
+
+bool SaveGameSnapshot(Snapshot *snapshot) {
+    Vector2 *paddlePos     = GetComponent(&world, paddle, COMP_POSITION);
+    PaddleComponent *shape = GetComponent(&world, paddle, COMP_PADDLE);
+    if (gameFlow.current != GAME_PLAYING || !paddlePos) return false;
+
+    GameSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, 4);
+    header.simClock         = simClock;
+    header.ballClock        = ballClock;
+    header.random[0]        = launchRandom;
+    header.random[1]        = ballRandom;
+    header.random[2]        = pickupRandom;
+    header.timerNow         = timers.now;
+    header.roundNumber      = roundNumber;
+    header.blockCount       = currentLevel.blockCount;
+    header.autopilotTarget  = autopilotTarget;
+    header.hp               = player.HP;
+    header.score            = player.currentScore;
+    header.ballSpeedScale   = ballSpeedScale;
+    header.laserCooldown    = laserCooldown;
+    header.timerCount       = (uint16_t)timers.pending;
+    header.ballCount        = (uint16_t)CountEntities(&world, ECS_MASK(COMP_BALL));
+    header.pickupCount      = (uint16_t)CountEntities(&world, ECS_MASK(COMP_PICKUP));
+    header.laserCount       = (uint16_t)lasers.count;
+    header.chainCount       = (uint16_t)chain.queued;
+    header.mainBall         = -1;
+    header.pendingEvent     = (int8_t)gameFlow.pendingEvent;
+    header.fourBallsSpawned = fourBallsSpawned;
+    for (int kind = 0; kind < POWERUP_KIND_COUNT; kind++) {
+        if (powerUpActive[kind]) header.powerUps |= 1u << kind;
+    }
+
+    // Everything is sized up front, so one reserve and then plain copies
+    BeginSnapshotWrite(snapshot);
+    unsigned char *out = ReserveSnapshot(snapshot, SnapshotSize(&header));
+    if (!out) return false;
+    unsigned char *headerOut = out;
+    out += sizeof(header);
+
+    out += sizeof(TimerRecord) * SaveTimers(&timers, (TimerRecord *)out, header.timerCount);
+
+    unsigned char *activeBits = out + sizeof(int32_t) * header.blockCount;
+    memset(activeBits, 0, ((size_t)header.blockCount + 7) / 8);
+    for (int i = 0; i < header.blockCount; i++) {
+        const Block *block = &currentLevel.blocks[i];
+        int32_t health = block->health;
+        memcpy(out + sizeof(int32_t) * i, &health, sizeof(health));
+        if (block->active) activeBits[i / 8] |= (unsigned char)(1u << (i % 8));
+    }
+    out = activeBits + ((size_t)header.blockCount + 7) / 8;
+
+    memcpy(out, paddlePos, sizeof(Vector2));
+    memcpy(out + sizeof(Vector2), shape, sizeof(PaddleComponent));
+    out += SNAPSHOT_PADDLE_BYTES;
+
+    // Balls, each field for all of them in turn
+    int n = header.ballCount, at = 0;
+    EcsIter it = QueryEntities(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_VELOCITY) |
+                                       ECS_MASK(COMP_COLLIDER) | ECS_MASK(COMP_BALL));
+    while (NextChunk(&it)) {
+        const EcsEntity *entities   = IterEntities(&it);
+        const BallComponent *balls  = IterColumn(&it, COMP_BALL);
+        const ColliderComponent *collider = IterColumn(&it, COMP_COLLIDER);
+        memcpy(out + sizeof(Vector2) * at, IterColumn(&it, COMP_POSITION), sizeof(Vector2) * it.count);
+        memcpy(out + sizeof(Vector2) * (n + at), IterColumn(&it, COMP_VELOCITY), sizeof(Vector2) * it.count);
+        for (int i = 0; i < it.count; i++) {
+            memcpy(out + sizeof(Vector2) * 2 * n + sizeof(float) * (at + i), &collider[i].radius, sizeof(float));
+            memcpy(out + (sizeof(Vector2) * 2 + sizeof(float)) * n + sizeof(Color) * (at + i), &balls[i].color, sizeof(Color));
+            if (entities[i] == mainBall) header.mainBall = (int16_t)(at + i);
+        }
+        at += it.count;
+    }
+    out += SNAPSHOT_BALL_BYTES * n;
+
+    n  = header.pickupCount;
+    at = 0;
+    it = QueryEntities(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_VELOCITY) |
+                               ECS_MASK(COMP_COLLIDER) | ECS_MASK(COMP_PICKUP));
+    while (NextChunk(&it)) {
+        const PickupComponent *pickups    = IterColumn(&it, COMP_PICKUP);
+        const ColliderComponent *collider = IterColumn(&it, COMP_COLLIDER);
+        memcpy(out + sizeof(Vector2) * at, IterColumn(&it, COMP_POSITION), sizeof(Vector2) * it.count);
+        memcpy(out + sizeof(Vector2) * (n + at), IterColumn(&it, COMP_VELOCITY), sizeof(Vector2) * it.count);
+        for (int i = 0; i < it.count; i++) {
+            memcpy(out + sizeof(Vector2) * 2 * n + sizeof(float) * (at + i), &collider[i].radius, sizeof(float));
+            out[(sizeof(Vector2) * 2 + sizeof(float)) * n + at + i] = (unsigned char)pickups[i].kind;
+        }
+        at += it.count;
+    }
+    out += SNAPSHOT_PICKUP_BYTES * n;
+
+    memcpy(out, lasers.x, sizeof(float) * header.laserCount);
+    memcpy(out + sizeof(float) * header.laserCount, lasers.y, sizeof(float) * header.laserCount);
+    out += 2 * sizeof(float) * header.laserCount;
+
+    for (int i = 0; i < header.chainCount; i++) {
+        int32_t index = chain.queue[(chain.head + i) % chain.blockCount];
+        memcpy(out + sizeof(int32_t) * i, &index, sizeof(index));
+    }
+
+    memcpy(headerOut, &header, sizeof(header));     // now with the main ball's index
+    return true;
+}
+
+// Every saved timer has to be one the round could have scheduled: due after
+// the snapshot was taken, with an argument in range for its kind
+static bool ValidSnapshotTimers(const TimerRecord *records, const GameSnapshotHeader *header) {
+    for (int i = 0; i < header->timerCount; i++) {
+        const TimerRecord *record = &records[i];
+        if (record->expires <= header->timerNow) return false;
+        if (record->kind == TIMER_POWERUP_EXPIRE && (record->arg < 0 || record->arg >= POWERUP_KIND_COUNT)) return false;
+        if (record->kind == TIMER_BLOCK_RESPAWN && (record->arg < 0 || record->arg >= header->blockCount)) return false;
+        if (record->kind != TIMER_POWERUP_EXPIRE && record->kind != TIMER_BLOCK_RESPAWN) return false;
+    }
+    return true;
+}
+
+// Gives up on the entities of a load that ran out of them, keeping the paddle
+static bool AbandonSnapshotEntities(void) {
+    EcsIter it = QueryEntities(&world, ECS_MASK(COMP_POSITION));
+    while (NextChunk(&it)) {
+        const EcsEntity *entities = IterEntities(&it);
+        for (int i = 0; i < it.count; i++) {
+            if (entities[i] != paddle) DeferDestroyEntity(&world, entities[i]);
+        }
+    }
+    FlushDestroyedEntities(&world);
+    mainBall = ECS_INVALID_ENTITY;
+    TraceLog(LOG_WARNING, "GAME: Snapshot entities did not fit in the world, balls and pickups dropped");
+    return false;
+}
+
+bool LoadGameSnapshot(Snapshot *snapshot) {
+    GameSnapshotHeader header;
+    BeginSnapshotRead(snapshot);
+    if (!ReadSnapshot(snapshot, &header, sizeof(header)) ||
+        memcmp(header.magic, SNAPSHOT_MAGIC, 4) != 0 || snapshot->size != SnapshotSize(&header) ||
+        gameFlow.current != GAME_PLAYING || header.roundNumber != roundNumber ||
+        header.blockCount != currentLevel.blockCount || header.timerCount > timers.capacity ||
+        header.laserCount > lasers.capacity || header.ballCount + header.pickupCount + 1 >= ECS_MAX_ENTITIES) {
+        return false;
+    }
+    const unsigned char *in = (const unsigned char *)snapshot->data + sizeof(header);
+    if (!ValidSnapshotTimers((const TimerRecord *)in, &header)) return false;
+
+    simClock       = header.simClock;
+    ballClock      = header.ballClock;
+    launchRandom   = header.random[0];
+    ballRandom     = header.random[1];
+    pickupRandom   = header.random[2];
+    autopilotTarget = header.autopilotTarget;
+    player.HP           = header.hp;
+    player.currentScore = header.score;
+    ballSpeedScale = header.ballSpeedScale;
+    laserCooldown  = header.laserCooldown;
+    fourBallsSpawned       = header.fourBallsSpawned;
+    gameFlow.pendingEvent  = header.pendingEvent;
+    blockHitCount  = 0;
+
+    ClearTimerWheel(&timers, header.timerNow);
+    for (int kind = 0; kind < POWERUP_KIND_COUNT; kind++) {
+        powerUpActive[kind] = (header.powerUps >> kind) & 1u;
+        powerUpTimers[kind] = TIMER_INVALID;
+    }
+    // Checked against the capacity above, so the cleared wheel has room for all
+    const TimerRecord *records = (const TimerRecord *)in;
+    for (int i = 0; i < header.timerCount; i++) {
+        TimerId timer = ScheduleTimer(&timers, records[i].expires - header.timerNow, records[i].kind, records[i].arg);
+        if (records[i].kind == TIMER_POWERUP_EXPIRE) powerUpTimers[records[i].arg] = timer;
+    }
+    in += sizeof(TimerRecord) * header.timerCount;
+
+    const unsigned char *activeBits = in + sizeof(int32_t) * header.blockCount;
+    liveBlocks  = 0;
+    blockDigest = 0;
+    for (int i = 0; i < header.blockCount; i++) {
+        Block *block = &currentLevel.blocks[i];
+        int32_t health;
+        memcpy(&health, in + sizeof(int32_t) * i, sizeof(health));
+        block->health = health;
+        block->active = (activeBits[i / 8] >> (i % 8)) & 1u;
+        if (block->active) liveBlocks++;
+        blockDigest ^= BlockHashTerm(i);
+    }
+    in = activeBits + ((size_t)header.blockCount + 7) / 8;
+
+    ClearEcsWorld(&world);
+    SpawnPaddle();
+    if (paddle == ECS_INVALID_ENTITY) return AbandonSnapshotEntities();
+    memcpy(GetComponent(&world, paddle, COMP_POSITION), in, sizeof(Vector2));
+    memcpy(GetComponent(&world, paddle, COMP_PADDLE), in + sizeof(Vector2), sizeof(PaddleComponent));
+    in += SNAPSHOT_PADDLE_BYTES;
+
+    int n = header.ballCount;
+    mainBall = ECS_INVALID_ENTITY;
+    for (int i = 0; i < n; i++) {
+        Vector2 position, velocity;
+        Color color;
+        memcpy(&position, in + sizeof(Vector2) * i, sizeof(Vector2));
+        memcpy(&velocity, in + sizeof(Vector2) * (n + i), sizeof(Vector2));
+        memcpy(&color, in + (sizeof(Vector2) * 2 + sizeof(float)) * n + sizeof(Color) * i, sizeof(Color));
+        EcsEntity ball = SpawnBall(position, velocity, color, i == header.mainBall);
+        if (ball == ECS_INVALID_ENTITY) return AbandonSnapshotEntities();
+        memcpy(&((ColliderComponent *)GetComponent(&world, ball, COMP_COLLIDER))->radius,
+               in + sizeof(Vector2) * 2 * n + sizeof(float) * i, sizeof(float));
+        if (i == header.mainBall) mainBall = ball;
+    }
+    in += SNAPSHOT_BALL_BYTES * n;
+
+    n = header.pickupCount;
+    for (int i = 0; i < n; i++) {
+        EcsEntity pickup = CreateEntity(&world, ECS_MASK(COMP_POSITION) | ECS_MASK(COMP_VELOCITY) |
+                                                ECS_MASK(COMP_COLLIDER) | ECS_MASK(COMP_PICKUP));
+        if (pickup == ECS_INVALID_ENTITY) return AbandonSnapshotEntities();
+        memcpy(GetComponent(&world, pickup, COMP_POSITION), in + sizeof(Vector2) * i, sizeof(Vector2));
+        memcpy(GetComponent(&world, pickup, COMP_VELOCITY), in + sizeof(Vector2) * (n + i), sizeof(Vector2));
+        memcpy(&((ColliderComponent *)GetComponent(&world, pickup, COMP_COLLIDER))->radius,
+               in + sizeof(Vector2) * 2 * n + sizeof(float) * i, sizeof(float));
+        ((PickupComponent *)GetComponent(&world, pickup, COMP_PICKUP))->kind =
+            (PowerUpKind)in[(sizeof(Vector2) * 2 + sizeof(float)) * n + i];
+    }
+    in += SNAPSHOT_PICKUP_BYTES * n;
+
+    lasers.count = header.laserCount;
+    memcpy(lasers.x, in, sizeof(float) * header.laserCount);
+    memcpy(lasers.y, in + sizeof(float) * header.laserCount, sizeof(float) * header.laserCount);
+    in += 2 * sizeof(float) * header.laserCount;
+
+    ClearChainReaction(&chain);
+    for (int i = 0; i < header.chainCount; i++) {
+        int32_t index;
+        memcpy(&index, in + sizeof(int32_t) * i, sizeof(index));
+        IgniteBlock(&chain, index);
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------
+//  F5 keeps the round as it is now, F9 goes back to it
+// ----------------------------------------------------------------------
+void QuickSaveSystem(void) {
+    if (IsActionPressed(ACTION_QUICK_SAVE)) {
+        double start = NowSeconds();
+        if (SaveGameSnapshot(&quickSave)) {
+            TraceLog(LOG_INFO, "GAME: Quick save, %zu bytes in %.1f us", quickSave.size, (NowSeconds() - start) * 1e6);
+        }
+        else {
+            TraceLog(LOG_WARNING, "GAME: Quick save failed");
+        }
+    }
+    if (IsActionPressed(ACTION_QUICK_LOAD)) {
+        double start = NowSeconds();
+        if (LoadGameSnapshot(&quickSave)) {
+            TraceLog(LOG_INFO, "GAME: Quick load in %.1f us", (NowSeconds() - start) * 1e6);
+        }
+        else {
+            TraceLog(LOG_WARNING, "GAME: Quick load failed");
+        }
+    }
+}
+
+// ----------------------------------------------------------------------
+//  [--record file | --replay file | --check-replay file] [--seed n]
+//  [--fixed-physics] [--endless] [--autopilot | --autopilot-aim]
+//  [level file or pack directory]
+// ----------------------------------------------------------------------
+void ParseArguments(int argc, char **argv) {
+    uint32_t seed = (uint32_t)time(NULL);
+    const char *recordPath = NULL;      // opened once the seed is settled
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if ((strcmp(argv[i], "--replay") == 0 || strcmp(argv[i], "--check-replay") == 0) && i + 1 < argc) {
+            checkReplay = strcmp(argv[i], "--check-replay") == 0;
+            if (!StartInputReplay(argv[++i], &seed)) {
+                TraceLog(LOG_WARNING, "INPUT: Failed to replay %s", argv[i]);
+                replayCheckFailed = checkReplay;
             }
-            fclose(file);
-        } else {
-            player.highscore = 0.0f;
         }
-    } else {
-        FILE *file = fopen("highscore.txt", "w");
-        if (file) {
-            fprintf(file, "%.0f\n", player.highscore);
-            fclose(file);
+        else if (strcmp(argv[i], "--fixed-physics") == 0) {
+            fixedPhysics = true;
+        }
+        else if (strcmp(argv[i], "--endless") == 0) {
+            blockRegeneration = true;
         }
+        else if (strcmp(argv[i], "--autopilot") == 0) {
+            autopilot = AUTOPILOT_CATCH;
+        }
+        else if (strcmp(argv[i], "--autopilot-aim") == 0) {
+            autopilot = AUTOPILOT_AIM;
+        }
+        else {
+            LoadLevelArgument(argv[i]);
+        }
+    }
+
+    if (recordPath && !StartInputRecording(recordPath, seed)) {
+        TraceLog(LOG_WARNING, "INPUT: Failed to record to %s", recordPath);
     }
+
+    // Same seed as the recorded session, so replays draw the same levels
+    gameSeed = seed;
 }
 
-int main(void) {
+int main(int argc, char **argv) {
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Block kuzushi raylib game build");
     SetTargetFPS(9000);
 
+    InitInput();
+    InitCheatCodes();
+    InitGameFlow();
+    ParseArguments(argc, argv);
+
     dataLoader(true);
+    StartIoWorker(&ioWorker);
+    if (!OpenLeaderboard(LEADERBOARD_PATH, &leaderboard)) {
+        TraceLog(LOG_WARNING, "LEADERBOARD: Failed to open %s", LEADERBOARD_PATH);
+    }
 
-    // Initialize paddle start position
-    playerX = SCREEN_WIDTH / 2.0f;
-    playerY = SCREEN_HEIGHT - 150.0f;
+    if (!InitEcsWorld(&world, 0) || !InitParticlePool(&particles, PARTICLE_CAPACITY) ||
+        !InitProjectilePool(&lasers, PROJECTILE_CAPACITY)) {
+        TraceLog(LOG_ERROR, "GAME: Failed to allocate entity, particle and projectile pools");
+        CloseWindow();
+        return 1;
+    }
 
-    while (!WindowShouldClose())
+    while (!WindowShouldClose() && !quitRequested && !replayCheckFailed)
     {
-        GameState();
+        PollInput();
+        if (checkReplay && !IsInputReplaying()) break;     // recording ran out
+        if (autopilot != AUTOPILOT_OFF) AutopilotMenus();
+        Upgrades();
+        UpdateStateMachine(&gameFlow);
+        CheckStateHash();
 
         BeginDrawing();
         ClearBackground(BLACK);
-
-        switch (currentState)
-        {
-            case NOT_STARTED:
-                InitializeGame();
-                break;
-
-            case GAME_OVER:
-                GameOver();
-                break;
-
-            case GAME_WIN:
-                WinScreen();
-                break;
-
-            case GAME_PLAYING:
-                Upgrades();
-                UpdateGame();
-                DrawGame();
-                break;
-
-            default:
-                break;
-        }
+        DrawStateMachine(&gameFlow);
         EndDrawing();
     }
+    LogStateMachineStats(&gameFlow);
+    if (checkReplay && !replayCheckFailed) {
+        TraceLog(LOG_INFO, "REPLAY: %u ticks checked, no divergence", checkedTicks);
+    }
     dataLoader(false);
+    CancelLevelPrefetch(&nextLevel);
+    UnloadLevel(&currentLevel);
+    UnloadLevelPack(&levelPack);
+    FreeTimerWheel(&timers);
+    FreeTrajectoryCache(&trajectories);
+    FreeSnapshot(&quickSave);
+    free(blockSpawnHealth);
+    FreeChainReaction(&chain);
+    FreeColumnIndex(&blockColumns);
+    FreeProjectilePool(&lasers);
+    FreeParticlePool(&particles);
+    FreeEcsWorld(&world);
     CloseWindow();
-    return 0;
+    StopInputRecording();
+    StopIoWorker(&ioWorker); // the window is gone, now let the save finish
+    if (atomic_load(&highscoreSaveMissed)) dataLoader(false);   // the worker is gone, so inline
+    CloseLeaderboard(&leaderboard);
+    return replayCheckFailed ? 1 : 0;
 }
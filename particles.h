@@ -0,0 +1,47 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "raylib.h"
+
+#define PARTICLE_CAPACITY  131072
+#define PARTICLE_SIZE      4.0f        // edge of the square each particle draws as
+#define PARTICLE_GRAVITY   900.0f      // pixels per second squared
+#define PARTICLE_DRAG      2.0f        // velocity decay per second
+
+// ----------------------------------------------------------------------
+//  Fixed-capacity particle pool, one array per field
+//
+//  Live particles are always [0, count): dead ones are swapped out with
+//  the last live one, so update and draw walk contiguous arrays and the
+//  integration loop vectorizes.
+// ----------------------------------------------------------------------
+typedef struct ParticlePool {
+    int capacity;
+    int count;
+
+    float *x;
+    float *y;
+    float *vx;
+    float *vy;
+    float *alpha;        // 1 when spawned, dead at 0
+    float *fade;         // alpha lost per second, 1 / lifetime
+    Color *color;
+
+    uint32_t rng;        // own generator, so effects never shift gameplay randomness
+} ParticlePool;
+
+bool InitParticlePool(ParticlePool *pool, int capacity);
+void FreeParticlePool(ParticlePool *pool);
+void ClearParticles(ParticlePool *pool);
+
+// Spawns up to count particles spread over area, flying outwards at up to
+// speed pixels per second. Silently drops what does not fit.
+void EmitParticleBurst(ParticlePool *pool, Rectangle area, Color color,
+                       int count, float speed, float lifetime);
+
+void UpdateParticles(ParticlePool *pool, float dt);
+void DrawParticles(const ParticlePool *pool);
+
+#endif // PARTICLES_H
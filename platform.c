@@ -0,0 +1,358 @@
+#include "platform.h"
+
+#include <string.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOGDI
+    #define NOUSER
+    #include <windows.h>
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <time.h>
+    #include <unistd.h>
+#endif
+#if defined(__linux__)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+#endif
+
+// ----------------------------------------------------------------------
+//  File mapping
+// ----------------------------------------------------------------------
+#if defined(_WIN32)
+
+bool MapFile(const char *path, MappedFile *file) {
+    memset(file, 0, sizeof(*file));
+
+    HANDLE fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(fileHandle, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    CloseHandle(fileHandle);
+    if (mapping == NULL) return false;
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (view == NULL) {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    file->data   = view;
+    file->size   = (size_t)fileSize.QuadPart;
+    file->handle = mapping;
+    file->fd     = -1;
+    return true;
+}
+
+bool MapFileShared(const char *path, size_t size, MappedFile *file) {
+    memset(file, 0, sizeof(*file));
+    file->fd = -1;
+
+    HANDLE fileHandle = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+                                    OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize)) {
+        CloseHandle(fileHandle);
+        return false;
+    }
+    if ((size_t)fileSize.QuadPart < size) {
+        LARGE_INTEGER newSize;
+        newSize.QuadPart = (LONGLONG)size;
+        if (!SetFilePointerEx(fileHandle, newSize, NULL, FILE_BEGIN) || !SetEndOfFile(fileHandle)) {
+            CloseHandle(fileHandle);
+            return false;
+        }
+    }
+
+    HANDLE mapping = CreateFileMappingA(fileHandle, NULL, PAGE_READWRITE, 0, 0, NULL);
+    if (mapping == NULL) {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (view == NULL) {
+        CloseHandle(mapping);
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    file->data       = view;
+    file->size       = size;
+    file->handle     = mapping;
+    file->fileHandle = fileHandle;
+    return true;
+}
+
+bool MapSharedMemory(const char *name, size_t size, bool create, MappedFile *file) {
+    memset(file, 0, sizeof(*file));
+    file->fd = -1;
+
+    // Pagefile-backed sections live while any process holds them open
+    const char *sectionName = (name[0] == '/') ? name + 1 : name;
+    HANDLE mapping = create ? CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                                 (DWORD)((uint64_t)size >> 32), (DWORD)size, sectionName)
+                            : OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, sectionName);
+    if (mapping == NULL) return false;
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (view == NULL) {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    file->data   = view;
+    file->size   = size;
+    file->handle = mapping;
+    return true;
+}
+
+void RemoveSharedMemory(const char *name) {
+    (void)name;   // gone once the last handle closes
+}
+
+bool FlushMappedRange(MappedFile *file, size_t offset, size_t size) {
+    return FlushViewOfFile((unsigned char *)file->data + offset, size) &&
+           FlushFileBuffers((HANDLE)file->fileHandle);
+}
+
+void UnmapFile(MappedFile *file) {
+    if (file->data)       UnmapViewOfFile(file->data);
+    if (file->handle)     CloseHandle((HANDLE)file->handle);
+    if (file->fileHandle) CloseHandle((HANDLE)file->fileHandle);
+    memset(file, 0, sizeof(*file));
+}
+
+#else
+
+bool MapFile(const char *path, MappedFile *file) {
+    memset(file, 0, sizeof(*file));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    void *view = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) return false;
+
+    file->data = view;
+    file->size = (size_t)st.st_size;
+    file->fd   = -1;
+    return true;
+}
+
+bool MapFileShared(const char *path, size_t size, MappedFile *file) {
+    memset(file, 0, sizeof(*file));
+    file->fd = -1;
+
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || ((size_t)st.st_size < size && ftruncate(fd, (off_t)size) != 0)) {
+        close(fd);
+        return false;
+    }
+
+    void *view = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+
+    file->data = view;
+    file->size = size;
+    file->fd   = fd;
+    return true;
+}
+
+bool MapSharedMemory(const char *name, size_t size, bool create, MappedFile *file) {
+    memset(file, 0, sizeof(*file));
+    file->fd = -1;
+
+    int fd = shm_open(name, create ? (O_RDWR | O_CREAT) : O_RDWR, 0600);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if ((create && ftruncate(fd, (off_t)size) != 0) ||
+        fstat(fd, &st) != 0 || (size_t)st.st_size < size) {
+        close(fd);
+        return false;
+    }
+
+    void *view = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+
+    file->data = view;
+    file->size = size;
+    file->fd   = fd;
+    return true;
+}
+
+void RemoveSharedMemory(const char *name) {
+    shm_unlink(name);
+}
+
+bool FlushMappedRange(MappedFile *file, size_t offset, size_t size) {
+    // msync wants a page-aligned start
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t start    = offset - offset % pageSize;
+    return msync((unsigned char *)file->data + start, size + (offset - start), MS_SYNC) == 0;
+}
+
+void UnmapFile(MappedFile *file) {
+    if (file->data) {
+        munmap(file->data, file->size);
+        if (file->fd >= 0) close(file->fd);
+    }
+    memset(file, 0, sizeof(*file));
+    file->fd = -1;
+}
+
+#endif
+
+// ----------------------------------------------------------------------
+//  Durable writes
+// ----------------------------------------------------------------------
+#if defined(_WIN32)
+
+bool FlushFileToDisk(FILE *file) {
+    return fflush(file) == 0 && _commit(_fileno(file)) == 0;
+}
+
+bool AtomicReplaceFile(const char *fromPath, const char *toPath) {
+    return MoveFileExA(fromPath, toPath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+void SyncParentDirectory(const char *path) {
+    (void)path;   // MOVEFILE_WRITE_THROUGH already covers the directory entry
+}
+
+#else
+
+bool FlushFileToDisk(FILE *file) {
+    return fflush(file) == 0 && fsync(fileno(file)) == 0;
+}
+
+bool AtomicReplaceFile(const char *fromPath, const char *toPath) {
+    return rename(fromPath, toPath) == 0;
+}
+
+void SyncParentDirectory(const char *path) {
+    char dir[1024];
+    const char *slash = strrchr(path, '/');
+    if (slash) {
+        size_t length = (size_t)(slash - path);
+        if (length == 0) length = 1;
+        if (length >= sizeof(dir)) return;
+        memcpy(dir, path, length);
+        dir[length] = '\0';
+    }
+    else {
+        strcpy(dir, ".");
+    }
+
+    int fd = open(dir, O_RDONLY);
+    if (fd < 0) return;
+    fsync(fd);
+    close(fd);
+}
+
+#endif
+
+// ----------------------------------------------------------------------
+//  Waiting on shared memory
+// ----------------------------------------------------------------------
+#if defined(__linux__)
+
+// Not FUTEX_PRIVATE: the waiter and the waker are different processes
+void WaitOnSharedWord(_Atomic uint32_t *word, uint32_t expected) {
+    syscall(SYS_futex, (uint32_t *)word, FUTEX_WAIT, expected, NULL, NULL, 0);
+}
+
+void WakeSharedWord(_Atomic uint32_t *word) {
+    syscall(SYS_futex, (uint32_t *)word, FUTEX_WAKE, INT32_MAX, NULL, NULL, 0);
+}
+
+#elif defined(_WIN32)
+
+// WaitOnAddress only sees threads of the same process
+void WaitOnSharedWord(_Atomic uint32_t *word, uint32_t expected) {
+    if (atomic_load(word) == expected) Sleep(0);
+}
+
+void WakeSharedWord(_Atomic uint32_t *word) {
+    (void)word;
+}
+
+#else
+
+void WaitOnSharedWord(_Atomic uint32_t *word, uint32_t expected) {
+    if (atomic_load(word) == expected) {
+        struct timespec pause = { 0, 50000 };
+        nanosleep(&pause, NULL);
+    }
+}
+
+void WakeSharedWord(_Atomic uint32_t *word) {
+    (void)word;
+}
+
+#endif
+
+// ----------------------------------------------------------------------
+//  Clock and CPU info
+// ----------------------------------------------------------------------
+#if defined(_WIN32)
+
+double NowSeconds(void) {
+    static LARGE_INTEGER frequency;
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+}
+
+int GetCpuCount(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors > 0) ? (int)info.dwNumberOfProcessors : 1;
+}
+
+#else
+
+double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int GetCpuCount(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (int)count : 1;
+}
+
+#endif
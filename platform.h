@@ -0,0 +1,56 @@
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// ----------------------------------------------------------------------
+//  Thin OS layer so the game code never has to #ifdef _WIN32 itself
+// ----------------------------------------------------------------------
+
+typedef struct MappedFile {
+    void  *data;
+    size_t size;
+    void  *handle;       // Windows mapping handle, unused on POSIX
+    void  *fileHandle;   // Windows file handle of shared mappings
+    int    fd;           // POSIX descriptor of shared mappings, -1 otherwise
+} MappedFile;
+
+// Maps a whole file copy-on-write: the pages are readable and writable,
+// but writes stay private to this process and never reach the file.
+bool MapFile(const char *path, MappedFile *file);
+void UnmapFile(MappedFile *file);
+
+// Maps a file read/write and shared, creating it or growing it to size
+// first. New bytes read as zero. Writes go back to the file.
+bool MapFileShared(const char *path, size_t size, MappedFile *file);
+
+// Named shared memory other processes can map by the same name ("/name" on
+// POSIX). create makes it, or resets its size; otherwise it must exist.
+bool MapSharedMemory(const char *name, size_t size, bool create, MappedFile *file);
+void RemoveSharedMemory(const char *name);
+
+// Blocks until the given range of a shared mapping has reached the disk.
+bool FlushMappedRange(MappedFile *file, size_t offset, size_t size);
+
+// Durable file replacement: flush a written file to the disk, then swap it
+// over the destination so readers see either the old or the new contents.
+bool FlushFileToDisk(FILE *file);
+bool AtomicReplaceFile(const char *fromPath, const char *toPath);
+void SyncParentDirectory(const char *path);
+
+// Cross-process wait on a 32-bit word in shared memory: sleeps while it
+// still holds expected (may return early, so recheck). A futex on Linux,
+// elsewhere a short sleep.
+void WaitOnSharedWord(_Atomic uint32_t *word, uint32_t expected);
+void WakeSharedWord(_Atomic uint32_t *word);
+
+// Monotonic clock that works without a window (raylib's GetTime needs one)
+double NowSeconds(void);
+
+int GetCpuCount(void);
+
+#endif // PLATFORM_H
@@ -0,0 +1,101 @@
+#include "projectiles.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "rlgl.h"
+#include "fixed_physics.h"
+
+#define PROJECTILE_DRAW_BATCH 1024
+
+bool InitProjectilePool(ProjectilePool *pool, int capacity) {
+    memset(pool, 0, sizeof(*pool));
+    pool->x = malloc(sizeof(float) * capacity);
+    pool->y = malloc(sizeof(float) * capacity);
+    if (!pool->x || !pool->y) {
+        FreeProjectilePool(pool);
+        return false;
+    }
+    pool->capacity = capacity;
+    return true;
+}
+
+void FreeProjectilePool(ProjectilePool *pool) {
+    free(pool->x);
+    free(pool->y);
+    memset(pool, 0, sizeof(*pool));
+}
+
+void ClearProjectiles(ProjectilePool *pool) {
+    pool->count = 0;
+}
+
+bool FireProjectile(ProjectilePool *pool, float x, float y) {
+    if (pool->count >= pool->capacity) return false;
+    pool->x[pool->count] = x;
+    pool->y[pool->count] = y;
+    pool->count++;
+    return true;
+}
+
+// ----------------------------------------------------------------------
+//  Each shot sweeps from its tip to where the tip will be, so a fast shot
+//  can never tunnel through a block between two frames
+// ----------------------------------------------------------------------
+int UpdateProjectiles(ProjectilePool *pool, const ColumnIndex *columns, const Block *blocks,
+                      float dt, bool fixed, int *hits, int maxHits) {
+    float step = PROJECTILE_SPEED * dt;
+    int32_t fixedStep = fixed ? ToFixedTime(dt) : 0;
+    int hitCount = 0;
+
+    int i = 0;
+    while (i < pool->count) {
+        float yTo = fixed ? FixedAdvance(pool->y[i], -PROJECTILE_SPEED, fixedStep) : pool->y[i] - step;
+        int block = (hitCount < maxHits)
+                  ? FindColumnHit(columns, blocks, pool->x[i], pool->y[i], yTo)
+                  : -1;
+
+        if (block >= 0) {
+            hits[hitCount++] = block;
+        }
+        else {
+            pool->y[i] = yTo;
+            if (yTo + PROJECTILE_LENGTH > 0.0f) {
+                i++;
+                continue;
+            }
+        }
+
+        // Hit something or left the top: last shot fills the hole
+        int last = --pool->count;
+        pool->x[i] = pool->x[last];
+        pool->y[i] = pool->y[last];
+    }
+    return hitCount;
+}
+
+// ----------------------------------------------------------------------
+//  All shots go out as quads in raylib's render batch in one pass
+// ----------------------------------------------------------------------
+void DrawProjectiles(const ProjectilePool *pool, Color color) {
+    const float w = PROJECTILE_WIDTH;
+    const float h = PROJECTILE_LENGTH;
+
+    rlSetTexture(0);
+    for (int start = 0; start < pool->count; start += PROJECTILE_DRAW_BATCH) {
+        int end = start + PROJECTILE_DRAW_BATCH;
+        if (end > pool->count) end = pool->count;
+
+        rlCheckRenderBatchLimit((end - start) * 4);
+        rlBegin(RL_QUADS);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        for (int i = start; i < end; i++) {
+            float x = pool->x[i] - w / 2;
+            float y = pool->y[i];
+            rlVertex2f(x,     y);
+            rlVertex2f(x,     y + h);
+            rlVertex2f(x + w, y + h);
+            rlVertex2f(x + w, y);
+        }
+        rlEnd();
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef PROJECTILES_H
+#define PROJECTILES_H
+
+#include <stdbool.h>
+#include "raylib.h"
+#include "column_index.h"
+
+#define PROJECTILE_CAPACITY  4096
+#define PROJECTILE_SPEED     1400.0f     // pixels per second, always straight up
+#define PROJECTILE_WIDTH     3.0f
+#define PROJECTILE_LENGTH    14.0f
+
+// ----------------------------------------------------------------------
+//  Laser shots, one array per field. Shots only ever move up, so each is
+//  resolved against its own block column rather than the whole level.
+// ----------------------------------------------------------------------
+typedef struct ProjectilePool {
+    int capacity;
+    int count;
+    float *x;
+    float *y;                // tip of the shot
+} ProjectilePool;
+
+bool InitProjectilePool(ProjectilePool *pool, int capacity);
+void FreeProjectilePool(ProjectilePool *pool);
+void ClearProjectiles(ProjectilePool *pool);
+
+bool FireProjectile(ProjectilePool *pool, float x, float y);
+
+// Moves every shot, removes those that hit a block or leave the screen and
+// writes the block indices they hit to hits. Returns the number of hits;
+// the caller applies the damage. Shots past maxHits fly on to next frame.
+// fixed moves them with FixedAdvance, for --fixed-physics.
+int UpdateProjectiles(ProjectilePool *pool, const ColumnIndex *columns, const Block *blocks,
+                      float dt, bool fixed, int *hits, int maxHits);
+
+void DrawProjectiles(const ProjectilePool *pool, Color color);
+
+#endif // PROJECTILES_H
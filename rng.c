@@ -0,0 +1,53 @@
+#include "rng.h"
+
+#define PCG_MULTIPLIER 6364136223846793005ull
+
+void SeedRandomStream(RandomStream *rng, uint64_t seed, uint64_t stream) {
+    rng->state     = 0;
+    rng->increment = (stream << 1) | 1u;
+    NextRandom(rng);
+    rng->state += seed;
+    NextRandom(rng);
+}
+
+// XSH RR: advance the LCG, output a rotated xorshift of the old state
+uint32_t NextRandom(RandomStream *rng) {
+    uint64_t old = rng->state;
+    rng->state = old * PCG_MULTIPLIER + rng->increment;
+
+    uint32_t shifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rotate  = (uint32_t)(old >> 59);
+    return (shifted >> rotate) | (shifted << ((0u - rotate) & 31));
+}
+
+// Multiply-shift onto the range, redrawing the few values that would make
+// the low end come up more often (Lemire)
+int RandomValue(RandomStream *rng, int min, int max) {
+    if (min > max) {
+        int swap = min;
+        min = max;
+        max = swap;
+    }
+    uint32_t range = (uint32_t)max - (uint32_t)min + 1u;
+    if (range == 0) return (int)NextRandom(rng);     // the whole 32-bit range
+
+    uint64_t product = (uint64_t)NextRandom(rng) * range;
+    uint32_t low = (uint32_t)product;
+    if (low < range) {
+        uint32_t threshold = (0u - range) % range;
+        while (low < threshold) {
+            product = (uint64_t)NextRandom(rng) * range;
+            low     = (uint32_t)product;
+        }
+    }
+    return (int)((uint32_t)min + (uint32_t)(product >> 32));
+}
+
+// splitmix64 finaliser over seed and index together
+uint32_t DeriveSeed(uint32_t seed, uint32_t index) {
+    uint64_t z = ((uint64_t)seed << 32 | index) + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return (uint32_t)(z >> 32);
+}
@@ -0,0 +1,40 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// Independent sequences drawn from one seed, one per thing that rolls dice,
+// so adding a roll in one never shifts what another sees
+typedef enum {
+    RANDOM_STREAM_LEVEL = 1,    // block health and types
+    RANDOM_STREAM_LAUNCH,       // main ball relaunch direction
+    RANDOM_STREAM_BALLS,        // extra ball angles
+    RANDOM_STREAM_PICKUPS,      // drops and their kinds
+} RandomStreamId;
+
+// ----------------------------------------------------------------------
+//  Seeded random numbers (PCG32)
+//
+//  16 bytes of state, owned by whoever draws from it, so games, threads
+//  and subsystems never share one and the same seed always gives the same
+//  numbers. The stream picks one of 2^63 distinct sequences for a seed.
+//  Not for anything security related.
+// ----------------------------------------------------------------------
+typedef struct RandomStream {
+    uint64_t state;
+    uint64_t increment;         // odd; selects the stream
+} RandomStream;
+
+void SeedRandomStream(RandomStream *rng, uint64_t seed, uint64_t stream);
+
+uint32_t NextRandom(RandomStream *rng);
+
+// Same contract as GetRandomValue: min and max both included, swapped if
+// out of order. Unbiased, unlike rand() % n.
+int RandomValue(RandomStream *rng, int min, int max);
+
+// Seed for the index-th thing made from seed (rounds of a game, games of a
+// batch), unrelated to its neighbours
+uint32_t DeriveSeed(uint32_t seed, uint32_t index);
+
+#endif // RNG_H
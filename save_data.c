@@ -0,0 +1,90 @@
+#include "save_data.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "checksum.h"
+#include "platform.h"
+
+static uint32_t lastSequence = 0;
+
+static uint32_t RecordChecksum(const SaveRecord *record) {
+    return Crc32(0, record, offsetof(SaveRecord, checksum));
+}
+
+static bool ReadRecord(const char *path, SaveRecord *record) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return false;
+
+    bool ok = fread(record, sizeof(*record), 1, file) == 1;
+    fclose(file);
+
+    return ok &&
+           memcmp(record->magic, SAVE_FILE_MAGIC, 4) == 0 &&
+           record->version == SAVE_FILE_VERSION &&
+           record->checksum == RecordChecksum(record);
+}
+
+// ----------------------------------------------------------------------
+//  Loading with fallbacks
+// ----------------------------------------------------------------------
+bool LoadHighscore(const char *path, float *highscore) {
+    char backupPath[512];
+    snprintf(backupPath, sizeof(backupPath), "%s.bak", path);
+
+    SaveRecord record;
+    if (ReadRecord(path, &record) || ReadRecord(backupPath, &record)) {
+        lastSequence = record.sequence;
+        *highscore   = record.highscore;
+        return true;
+    }
+
+    // Highscores from before the binary format
+    FILE *legacy = fopen(SAVE_LEGACY_PATH, "r");
+    if (legacy) {
+        float storedHighscore = 0.0f;
+        bool ok = fscanf(legacy, "%f", &storedHighscore) == 1;
+        fclose(legacy);
+        if (ok) {
+            *highscore = storedHighscore;
+            return true;
+        }
+    }
+
+    *highscore = 0.0f;
+    return false;
+}
+
+// ----------------------------------------------------------------------
+//  Crash-safe save
+// ----------------------------------------------------------------------
+bool SaveHighscore(const char *path, float highscore) {
+    char tempPath[512], backupPath[512];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+    snprintf(backupPath, sizeof(backupPath), "%s.bak", path);
+
+    SaveRecord record;
+    memset(&record, 0, sizeof(record));
+    memcpy(record.magic, SAVE_FILE_MAGIC, 4);
+    record.version   = SAVE_FILE_VERSION;
+    record.sequence  = ++lastSequence;
+    record.highscore = highscore;
+    record.checksum  = RecordChecksum(&record);
+
+    FILE *file = fopen(tempPath, "wb");
+    if (!file) return false;
+
+    bool ok = fwrite(&record, sizeof(record), 1, file) == 1 && FlushFileToDisk(file);
+    if (fclose(file) != 0) ok = false;
+    if (!ok) {
+        remove(tempPath);
+        return false;
+    }
+
+    // If we die between these two renames, path is missing and the loader
+    // picks up the backup, which is the previous good save.
+    AtomicReplaceFile(path, backupPath);
+    ok = AtomicReplaceFile(tempPath, path);
+    SyncParentDirectory(path);
+    return ok;
+}
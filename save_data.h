@@ -0,0 +1,33 @@
+#ifndef SAVE_DATA_H
+#define SAVE_DATA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SAVE_FILE_PATH     "highscore.dat"
+#define SAVE_LEGACY_PATH   "highscore.txt"
+#define SAVE_FILE_MAGIC    "BKHS"
+#define SAVE_FILE_VERSION  1
+
+// ----------------------------------------------------------------------
+//  Highscore record, written whole and checked by CRC-32 on load
+// ----------------------------------------------------------------------
+typedef struct SaveRecord {
+    char     magic[4];
+    uint32_t version;
+    uint32_t sequence;       // bumped on every save, handy when debugging cabinets
+    float    highscore;
+    uint32_t reserved;
+    uint32_t checksum;       // CRC-32 of every field above
+} SaveRecord;
+
+// Tries path, then the previous good copy (path.bak), then the old text
+// file. Returns false only if none of them holds a valid highscore.
+bool LoadHighscore(const char *path, float *highscore);
+
+// Write-to-temp, flush to disk, then rename over path. The copy being
+// replaced is kept as path.bak. Blocking; call it from the I/O thread,
+// and from one thread at a time: the temp file and sequence are shared.
+bool SaveHighscore(const char *path, float highscore);
+
+#endif // SAVE_DATA_H
@@ -0,0 +1,194 @@
+#include "sequence_matcher.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include "raylib.h"
+
+typedef struct KeyName {
+    const char *name;
+    int key;
+} KeyName;
+
+static const KeyName namedKeys[] = {
+    { "SPACE", KEY_SPACE }, { "ENTER", KEY_ENTER }, { "TAB", KEY_TAB },
+    { "BACKSPACE", KEY_BACKSPACE }, { "ESCAPE", KEY_ESCAPE },
+    { "UP", KEY_UP }, { "DOWN", KEY_DOWN }, { "LEFT", KEY_LEFT }, { "RIGHT", KEY_RIGHT },
+    { "INSERT", KEY_INSERT }, { "DELETE", KEY_DELETE }, { "HOME", KEY_HOME }, { "END", KEY_END },
+    { "PAGE_UP", KEY_PAGE_UP }, { "PAGE_DOWN", KEY_PAGE_DOWN },
+};
+
+// ----------------------------------------------------------------------
+//  "A".."Z", "0".."9", "F1".."F12", "KP_0".."KP_9" and the table above
+// ----------------------------------------------------------------------
+static int KeyFromName(const char *name) {
+    if (name[0] && !name[1]) {
+        char c = (char)toupper((unsigned char)name[0]);
+        if (c >= 'A' && c <= 'Z') return KEY_A + (c - 'A');
+        if (c >= '0' && c <= '9') return KEY_ZERO + (c - '0');
+    }
+    if (name[0] == 'F' && isdigit((unsigned char)name[1])) {
+        int n = 0;
+        if (sscanf(name + 1, "%d", &n) == 1 && n >= 1 && n <= 12) return KEY_F1 + (n - 1);
+    }
+    if (strncmp(name, "KP_", 3) == 0 && isdigit((unsigned char)name[3]) && !name[4]) {
+        return KEY_KP_0 + (name[3] - '0');
+    }
+    for (size_t i = 0; i < sizeof(namedKeys) / sizeof(namedKeys[0]); i++) {
+        if (strcmp(name, namedKeys[i].name) == 0) return namedKeys[i].key;
+    }
+    return KEY_NULL;
+}
+
+void InitSequenceMatcher(SequenceMatcher *matcher) {
+    memset(matcher, 0, sizeof(*matcher));
+    matcher->symbolCount = 1;   // symbol 0 is "a key no code uses"
+    matcher->stateCount  = 1;   // state 0 is the root, which loops on everything
+}
+
+bool AddSequenceCode(SequenceMatcher *matcher, const char *name, const char *action,
+                     const int *keys, int length) {
+    if (matcher->codeCount >= SEQ_MAX_CODES || length <= 0 || length > SEQ_MAX_LENGTH ||
+        matcher->totalLength + length >= SEQ_MAX_STATES) {
+        return false;
+    }
+
+    int newSymbols = 0;
+    for (int i = 0; i < length; i++) {
+        if (keys[i] <= KEY_NULL || keys[i] >= INPUT_KEY_CODES) return false;
+        if (matcher->symbolOfKey[keys[i]] != 0) continue;
+
+        bool seen = false;
+        for (int j = 0; j < i; j++) seen = seen || keys[j] == keys[i];
+        if (!seen) newSymbols++;
+    }
+    if (matcher->symbolCount + newSymbols > SEQ_MAX_SYMBOLS) return false;
+
+    for (int i = 0; i < length; i++) {
+        if (matcher->symbolOfKey[keys[i]] == 0) {
+            matcher->symbolOfKey[keys[i]] = (uint8_t)matcher->symbolCount++;
+        }
+    }
+
+    SequenceCode *code = &matcher->codes[matcher->codeCount++];
+    snprintf(code->name, sizeof(code->name), "%s", name);
+    snprintf(code->action, sizeof(code->action), "%s", action);
+    memcpy(code->keys, keys, length * sizeof(int));
+    code->length = length;
+
+    matcher->totalLength += length;
+    matcher->built = false;
+    return true;
+}
+
+// ----------------------------------------------------------------------
+//  Trie from the code list, then a BFS that turns missing edges into the
+//  failure state's edge, which is what makes feeding a single lookup
+// ----------------------------------------------------------------------
+void BuildSequenceMatcher(SequenceMatcher *matcher) {
+    int16_t fail[SEQ_MAX_STATES];
+    int16_t queue[SEQ_MAX_STATES];
+
+    for (int c = 0; c < SEQ_MAX_SYMBOLS; c++) matcher->next[0][c] = -1;
+    matcher->output[0]  = 0;
+    matcher->stateCount = 1;
+
+    for (int i = 0; i < matcher->codeCount; i++) {
+        const SequenceCode *code = &matcher->codes[i];
+        int state = 0;
+        for (int k = 0; k < code->length; k++) {
+            int symbol = matcher->symbolOfKey[code->keys[k]];
+            if (matcher->next[state][symbol] < 0) {
+                int fresh = matcher->stateCount++;
+                for (int c = 0; c < SEQ_MAX_SYMBOLS; c++) matcher->next[fresh][c] = -1;
+                matcher->output[fresh] = 0;
+                matcher->next[state][symbol] = (int16_t)fresh;
+            }
+            state = matcher->next[state][symbol];
+        }
+        matcher->output[state] |= 1ull << i;
+    }
+
+    int head = 0, tail = 0;
+    for (int c = 0; c < SEQ_MAX_SYMBOLS; c++) {
+        int child = matcher->next[0][c];
+        if (child < 0) {
+            matcher->next[0][c] = 0;
+        }
+        else {
+            fail[child] = 0;
+            queue[tail++] = (int16_t)child;
+        }
+    }
+
+    while (head < tail) {
+        int state = queue[head++];
+        matcher->output[state] |= matcher->output[fail[state]];
+
+        for (int c = 0; c < SEQ_MAX_SYMBOLS; c++) {
+            int child = matcher->next[state][c];
+            if (child < 0) {
+                matcher->next[state][c] = matcher->next[fail[state]][c];
+            }
+            else {
+                fail[child] = matcher->next[fail[state]][c];
+                queue[tail++] = (int16_t)child;
+            }
+        }
+    }
+
+    matcher->state = 0;
+    matcher->built = true;
+}
+
+// ----------------------------------------------------------------------
+//  Config file
+// ----------------------------------------------------------------------
+bool LoadSequenceCodes(SequenceMatcher *matcher, const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) return false;
+
+    char line[512];
+    int lineNumber = 0;
+    while (fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        char *comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        char *name   = strtok(line, " \t\r\n");
+        char *action = name ? strtok(NULL, " \t\r\n") : NULL;
+        if (!name) continue;
+
+        int keys[SEQ_MAX_LENGTH];
+        int length = 0;
+        bool valid = action != NULL;
+        for (char *token = strtok(NULL, " \t\r\n"); valid && token; token = strtok(NULL, " \t\r\n")) {
+            int key = KeyFromName(token);
+            valid = key != KEY_NULL && length < SEQ_MAX_LENGTH;
+            if (valid) keys[length++] = key;
+        }
+
+        if (!valid || !AddSequenceCode(matcher, name, action, keys, length)) {
+            TraceLog(LOG_WARNING, "CODES: %s:%d: skipping invalid code '%s'", path, lineNumber, name);
+        }
+    }
+    fclose(file);
+
+    BuildSequenceMatcher(matcher);
+    return true;
+}
+
+// ----------------------------------------------------------------------
+//  Matching
+// ----------------------------------------------------------------------
+uint64_t FeedSequenceKey(SequenceMatcher *matcher, int key) {
+    if (!matcher->built) return 0;
+
+    int symbol = (key > KEY_NULL && key < INPUT_KEY_CODES) ? matcher->symbolOfKey[key] : 0;
+    matcher->state = matcher->next[matcher->state][symbol];
+    return matcher->output[matcher->state];
+}
+
+void ResetSequenceMatcher(SequenceMatcher *matcher) {
+    matcher->state = 0;
+}
@@ -0,0 +1,61 @@
+#ifndef SEQUENCE_MATCHER_H
+#define SEQUENCE_MATCHER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "input.h"
+
+#define SEQ_MAX_CODES     64     // one bit each in the match mask
+#define SEQ_MAX_STATES    1024
+#define SEQ_MAX_SYMBOLS   64     // distinct keys across all codes, plus "other"
+#define SEQ_MAX_LENGTH    32
+#define SEQ_NAME_LENGTH   32
+
+typedef struct SequenceCode {
+    char name[SEQ_NAME_LENGTH];
+    char action[SEQ_NAME_LENGTH];
+    int keys[SEQ_MAX_LENGTH];
+    int length;
+} SequenceCode;
+
+// ----------------------------------------------------------------------
+//  Aho-Corasick automaton over key events
+//
+//  All codes are matched at once, overlapping prefixes included (UP UP UP
+//  DOWN still completes UP UP DOWN ...). Building turns the trie into a
+//  full transition table, so every key event is exactly one lookup.
+// ----------------------------------------------------------------------
+typedef struct SequenceMatcher {
+    SequenceCode codes[SEQ_MAX_CODES];
+    int codeCount;
+
+    int totalLength;                        // bounds the trie size
+
+    uint8_t symbolOfKey[INPUT_KEY_CODES];   // 0 for keys no code uses
+    int symbolCount;
+
+    int16_t next[SEQ_MAX_STATES][SEQ_MAX_SYMBOLS];
+    uint64_t output[SEQ_MAX_STATES];        // codes ending here, suffixes included
+    int stateCount;
+    bool built;
+
+    int state;
+} SequenceMatcher;
+
+void InitSequenceMatcher(SequenceMatcher *matcher);
+
+// Codes only take effect after the next BuildSequenceMatcher.
+bool AddSequenceCode(SequenceMatcher *matcher, const char *name, const char *action,
+                     const int *keys, int length);
+void BuildSequenceMatcher(SequenceMatcher *matcher);
+
+// Config lines: "<name> <action> <KEY> <KEY> ...", '#' starts a comment.
+// Keys use raylib names without the KEY_ prefix (UP, A, F1, KP_5...).
+// Adds to whatever is already in the matcher and rebuilds it.
+bool LoadSequenceCodes(SequenceMatcher *matcher, const char *path);
+
+// Advances on one key and returns the mask of codes completed by it.
+uint64_t FeedSequenceKey(SequenceMatcher *matcher, int key);
+void ResetSequenceMatcher(SequenceMatcher *matcher);
+
+#endif // SEQUENCE_MATCHER_H
@@ -0,0 +1,260 @@
+#include "sim.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "level.h"
+
+typedef char SimCellWidthCheck[(SIM_CELL_WIDTH == BLOCK_WIDTH + BLOCK_SPACING) ? 1 : -1];
+typedef char SimCellHeightCheck[(SIM_CELL_HEIGHT == BLOCK_HEIGHT + BLOCK_SPACING) ? 1 : -1];
+
+// LevelGridRect without linking level.c, which needs raylib
+static Rectangle SimCellRect(int row, int col) {
+    return (Rectangle){ (float)(col * SIM_CELL_WIDTH + LEVEL_GRID_X), (float)(row * SIM_CELL_HEIGHT + LEVEL_GRID_Y),
+                        BLOCK_WIDTH, BLOCK_HEIGHT };
+}
+
+// Same test as raylib's CheckCollisionCircleRec
+static bool CircleTouchesRect(float cx, float cy, float radius, Rectangle rect) {
+    float halfWidth  = rect.width / 2.0f;
+    float halfHeight = rect.height / 2.0f;
+    float dx = fabsf(cx - (rect.x + halfWidth));
+    float dy = fabsf(cy - (rect.y + halfHeight));
+
+    if (dx > halfWidth + radius || dy > halfHeight + radius) return false;
+    if (dx <= halfWidth || dy <= halfHeight) return true;
+
+    float cornerX = dx - halfWidth;
+    float cornerY = dy - halfHeight;
+    return cornerX * cornerX + cornerY * cornerY <= radius * radius;
+}
+
+// ----------------------------------------------------------------------
+//  Lifetime
+// ----------------------------------------------------------------------
+bool InitSimGame(SimGame *game, const SimConfig *config, uint32_t seed) {
+    memset(game, 0, sizeof(*game));
+    if (config->rows <= 0 || config->cols <= 0) return false;
+
+    game->config     = *config;
+    game->blockCount = config->rows * config->cols;
+    game->health     = malloc(game->blockCount);
+    game->explosive  = malloc(game->blockCount);
+    game->chainQueue = malloc(sizeof(int) * game->blockCount);
+    if (!game->health || !game->explosive || !game->chainQueue) {
+        FreeSimGame(game);
+        return false;
+    }
+
+    ResetSimGame(game, seed);
+    return true;
+}
+
+void FreeSimGame(SimGame *game) {
+    free(game->health);
+    free(game->explosive);
+    free(game->chainQueue);
+    memset(game, 0, sizeof(*game));
+}
+
+static void LaunchMainBall(SimGame *game) {
+    SimBall *ball = &game->balls[0];
+    ball->x      = game->paddleX + SIM_SCREEN_WIDTH / 50;
+    ball->y      = game->paddleY;
+    ball->vx     = (RandomValue(&game->launchRandom, 0, 1) == 0) ? -SIM_BALL_SPEED / 2 : SIM_BALL_SPEED / 2;
+    ball->vy     = -SIM_BALL_SPEED;
+    ball->active = true;
+}
+
+void ResetSimGame(SimGame *game, uint32_t seed) {
+    game->seed = seed;
+    SeedRandomStream(&game->launchRandom, seed, RANDOM_STREAM_LAUNCH);
+    SeedRandomStream(&game->ballRandom, seed, RANDOM_STREAM_BALLS);
+
+    // Drawn exactly as GenerateLevel does, so a seed is the same level in both
+    if (game->config.layout) {
+        memcpy(game->health, game->config.layout, game->blockCount);
+        if (game->config.explosive) memcpy(game->explosive, game->config.explosive, game->blockCount);
+        else                        memset(game->explosive, 0, game->blockCount);
+    }
+    else {
+        RandomStream levelRandom;
+        SeedRandomStream(&levelRandom, seed, RANDOM_STREAM_LEVEL);
+        for (int i = 0; i < game->blockCount; i++) {
+            game->explosive[i] = (RandomValue(&levelRandom, 1, EXPLOSIVE_BLOCK_CHANCE) == 1);
+            game->health[i]    = game->explosive[i] ? 1 : (unsigned char)RandomValue(&levelRandom, 1, 3);
+        }
+    }
+    game->chainHead  = 0;
+    game->chainTail  = 0;
+    game->blastCount = 0;
+    game->startBlocks = 0;
+    for (int i = 0; i < game->blockCount; i++) game->startBlocks += (game->health[i] != 0);
+    game->liveBlocks = game->startBlocks;
+    game->hitCount   = 0;
+
+    game->paddleX = SIM_SCREEN_WIDTH / 2.0f;
+    game->paddleY = SIM_SCREEN_HEIGHT - 150.0f;
+    memset(game->balls, 0, sizeof(game->balls));
+    game->balls[0] = (SimBall){ game->paddleX + 40.0f, game->paddleY - 40.0f,
+                                SIM_BALL_SPEED, -SIM_BALL_SPEED, true };
+    game->extraBallsSpawned = false;
+
+    game->hp      = game->config.startHP;
+    game->hpLost  = 0;
+    game->score   = 0;
+    game->tick    = 0;
+    game->outcome = SIM_RUNNING;
+}
+
+// ----------------------------------------------------------------------
+//  Rules, in the order UpdateGame runs them
+// ----------------------------------------------------------------------
+static void SpawnExtraBalls(SimGame *game) {
+    const SimBall *mainBall = &game->balls[0];
+    float originX = mainBall->active ? mainBall->x : game->paddleX + SIM_PADDLE_WIDTH / 2;
+    float originY = mainBall->active ? mainBall->y : game->paddleY - SIM_BALL_RADIUS * 2;
+
+    for (int i = 1; i < SIM_MAX_BALLS; i++) {
+        float angle = RandomValue(&game->ballRandom, 0, 359) * (3.14159265f / 180.0f);
+        game->balls[i] = (SimBall){ originX, originY,
+                                    cosf(angle) * SIM_BALL_SPEED, sinf(angle) * SIM_BALL_SPEED, true };
+    }
+}
+
+static void MoveBall(SimGame *game, SimBall *ball) {
+    ball->x += ball->vx * SIM_DT;
+    ball->y += ball->vy * SIM_DT;
+
+    if ((ball->x - SIM_BALL_RADIUS <= 0 && ball->vx < 0) ||
+        (ball->x + SIM_BALL_RADIUS >= SIM_SCREEN_WIDTH && ball->vx > 0)) ball->vx *= -1.0f;
+    if (ball->y - SIM_BALL_RADIUS <= 0 && ball->vy < 0) ball->vy *= -1.0f;
+    if (ball->y + SIM_BALL_RADIUS >= SIM_SCREEN_HEIGHT) {
+        ball->active = false;
+        game->hp--;
+        game->hpLost++;
+    }
+}
+
+static void BounceOffPaddle(const SimGame *game, SimBall *ball) {
+    Rectangle paddle = { game->paddleX, game->paddleY, SIM_PADDLE_WIDTH, SIM_PADDLE_HEIGHT };
+    if (!CircleTouchesRect(ball->x, ball->y, SIM_BALL_RADIUS, paddle)) return;
+
+    float hitPos = (ball->x - paddle.x) / paddle.width;
+    ball->vy = -SIM_BALL_SPEED;
+    ball->vx = (hitPos - 0.5f) * SIM_BALL_SPEED * 2.0f;
+}
+
+// One hit, from a ball or a blast, as DamageBlock in main.c
+static void DamageCell(SimGame *game, int index) {
+    if (--game->health[index] > 0) return;
+    game->liveBlocks--;
+    game->score += 100;
+    if (game->explosive[index]) game->chainQueue[game->chainTail++] = index;
+}
+
+// Only the cells under the ball's bounds are tested, in block index order,
+// so the first hit is the same one the full scan in main.c would find
+static void HitBlocks(SimGame *game, SimBall *ball) {
+    int firstCol = (int)floorf((ball->x - SIM_BALL_RADIUS - LEVEL_GRID_X) / SIM_CELL_WIDTH);
+    int lastCol  = (int)floorf((ball->x + SIM_BALL_RADIUS - LEVEL_GRID_X) / SIM_CELL_WIDTH);
+    int firstRow = (int)floorf((ball->y - SIM_BALL_RADIUS - LEVEL_GRID_Y) / SIM_CELL_HEIGHT);
+    int lastRow  = (int)floorf((ball->y + SIM_BALL_RADIUS - LEVEL_GRID_Y) / SIM_CELL_HEIGHT);
+    if (firstCol < 0) firstCol = 0;
+    if (firstRow < 0) firstRow = 0;
+    if (lastCol >= game->config.cols) lastCol = game->config.cols - 1;
+    if (lastRow >= game->config.rows) lastRow = game->config.rows - 1;
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int col = firstCol; col <= lastCol; col++) {
+            int index = row * game->config.cols + col;
+            if (game->health[index] == 0) continue;
+            if (!CircleTouchesRect(ball->x, ball->y, SIM_BALL_RADIUS, SimCellRect(row, col))) continue;
+
+            game->hitBlocks[game->hitCount++] = index;
+            DamageCell(game, index);
+            ball->vy *= -1.0f;
+            return;
+        }
+    }
+}
+
+// StepChainReaction on the grid: each explosion hits the eight cells
+// around it, and what it sets off waits for a later tick once the budget
+// is spent
+static void StepChain(SimGame *game) {
+    int rows = game->config.rows, cols = game->config.cols;
+    for (game->blastCount = 0;
+         game->blastCount < SIM_CHAIN_BUDGET && game->chainHead < game->chainTail; game->blastCount++) {
+        int index = game->chainQueue[game->chainHead++];
+        int row = index / cols, col = index % cols;
+        for (int r = row - 1; r <= row + 1; r++) {
+            if (r < 0 || r >= rows) continue;
+            for (int c = col - 1; c <= col + 1; c++) {
+                if (c < 0 || c >= cols || (r == row && c == col)) continue;
+                if (game->health[r * cols + c] != 0) DamageCell(game, r * cols + c);
+            }
+        }
+    }
+}
+
+static void MovePaddle(SimGame *game, SimAction action) {
+    if (action == SIM_MOVE_LEFT && game->paddleX > 0) {
+        game->paddleX -= SIM_PADDLE_SPEED * SIM_DT;
+    }
+    else if (action == SIM_MOVE_RIGHT && game->paddleX + SIM_PADDLE_WIDTH < SIM_SCREEN_WIDTH) {
+        game->paddleX += SIM_PADDLE_SPEED * SIM_DT;
+    }
+}
+
+SimOutcome StepSimGame(SimGame *game, SimAction action) {
+    if (game->outcome != SIM_RUNNING) return game->outcome;
+    game->hitCount = 0;
+
+    if (!game->balls[0].active) LaunchMainBall(game);
+    if (!game->extraBallsSpawned && game->score >= SIM_EXTRA_BALL_SCORE) {
+        SpawnExtraBalls(game);
+        game->extraBallsSpawned = true;
+    }
+
+    for (int i = 0; i < SIM_MAX_BALLS; i++) {
+        if (game->balls[i].active) MoveBall(game, &game->balls[i]);
+    }
+    for (int i = 0; i < SIM_MAX_BALLS; i++) {
+        if (game->balls[i].active) BounceOffPaddle(game, &game->balls[i]);
+    }
+    for (int i = 0; i < SIM_MAX_BALLS; i++) {
+        if (game->balls[i].active) HitBlocks(game, &game->balls[i]);
+    }
+    StepChain(game);
+    MovePaddle(game, action);
+    game->tick++;
+
+    // A clear beats a loss on the same tick, as in UpdateGame
+    if (game->liveBlocks == 0)                                          game->outcome = SIM_CLEARED;
+    else if (game->hp <= 0)                                             game->outcome = SIM_LOST;
+    else if (game->config.maxTicks > 0 && game->tick >= game->config.maxTicks) game->outcome = SIM_TIMED_OUT;
+    return game->outcome;
+}
+
+// ----------------------------------------------------------------------
+//  Reference AI
+// ----------------------------------------------------------------------
+SimAction SimChaseAction(const SimGame *game) {
+    const SimBall *target = NULL;
+    for (int i = 0; i < SIM_MAX_BALLS; i++) {
+        const SimBall *ball = &game->balls[i];
+        if (!ball->active || ball->vy <= 0) continue;
+        if (!target || ball->y > target->y) target = ball;
+    }
+    if (!target) return SIM_MOVE_NONE;
+
+    // Return off centre, and move the spot every few seconds so the ball
+    // does not settle into one loop that misses the last blocks
+    int phase    = (game->tick / (SIM_TICK_RATE * 3)) % 5;
+    float aim    = game->paddleX + SIM_PADDLE_WIDTH * (0.2f + 0.15f * phase);
+    float margin = SIM_PADDLE_SPEED * SIM_DT;
+    if (target->x < aim - margin) return SIM_MOVE_LEFT;
+    if (target->x > aim + margin) return SIM_MOVE_RIGHT;
+    return SIM_MOVE_NONE;
+}
@@ -0,0 +1,109 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "rng.h"
+
+// Same playfield and tuning as the interactive game in main.c
+#define SIM_SCREEN_WIDTH   1800.0f
+#define SIM_SCREEN_HEIGHT  900.0f
+#define SIM_PADDLE_WIDTH   (SIM_SCREEN_WIDTH / 20.0f)
+#define SIM_PADDLE_HEIGHT  (SIM_SCREEN_HEIGHT / 50.0f)
+#define SIM_PADDLE_SPEED   2000.0f
+#define SIM_BALL_SPEED     1000.0f
+#define SIM_BALL_RADIUS    8.0f
+#define SIM_MAX_BALLS      5        // the main ball and the four extra
+#define SIM_EXTRA_BALL_SCORE 4000
+#define SIM_TICK_RATE      120      // fixed steps per simulated second
+#define SIM_DT             (1.0f / SIM_TICK_RATE)
+#define SIM_CHAIN_BUDGET   32       // explosions per tick, CHAIN_REACTION_BUDGET in game
+#define SIM_CELL_WIDTH     110      // BLOCK_WIDTH + BLOCK_SPACING, the standard grid's pitch
+#define SIM_CELL_HEIGHT    40       // BLOCK_HEIGHT + BLOCK_SPACING
+
+typedef enum {
+    SIM_MOVE_NONE  = 0,
+    SIM_MOVE_LEFT  = 1,
+    SIM_MOVE_RIGHT = 2,
+    SIM_ACTION_COUNT
+} SimAction;
+
+typedef enum {
+    SIM_RUNNING = 0,
+    SIM_CLEARED,             // every block destroyed
+    SIM_LOST,                // out of HP
+    SIM_TIMED_OUT,           // hit maxTicks first
+} SimOutcome;
+
+typedef struct SimConfig {
+    int rows;
+    int cols;
+    int startHP;
+    int maxTicks;            // 0 = no limit
+    const unsigned char *layout;    // rows * cols starting health, 0 for an empty
+                                    // cell; NULL draws a new level from each seed
+    const unsigned char *explosive; // rows * cols, nonzero marks an explosive cell
+                                    // of layout; NULL for none
+} SimConfig;
+
+typedef struct SimBall {
+    float x, y;
+    float vx, vy;
+    bool active;
+} SimBall;
+
+// ----------------------------------------------------------------------
+//  Headless game instance
+//
+//  Everything one game needs lives here, including its own random state,
+//  so any number of them can run side by side on different threads. The
+//  rules are the core ones from main.c (paddle, balls, block health,
+//  lives, the extra balls at 4000 points and explosive chains) stepped
+//  at a fixed rate; power-ups and lasers stay in the interactive game.
+//  Blocks sit on the standard grid, one health byte per cell. A config
+//  layout fixes the level so only the launch and the extra balls vary.
+// ----------------------------------------------------------------------
+typedef struct SimGame {
+    SimConfig config;
+    uint32_t seed;                  // of the current game
+    RandomStream launchRandom;
+    RandomStream ballRandom;
+
+    unsigned char *health;   // rows * cols, 0 once destroyed
+    unsigned char *explosive;       // rows * cols, set for explosive cells
+    int *chainQueue;         // destroyed explosives waiting to go off; a
+    int chainHead;           // cell is destroyed once a game, so no ring
+    int chainTail;
+    int blockCount;          // cells
+    int startBlocks;         // blocks the level starts with
+    int liveBlocks;
+    int hitBlocks[SIM_MAX_BALLS];   // damaged during the last step
+    int hitCount;
+    int blastCount;          // explosions during the last step; they may
+                             // have damaged any number of blocks
+
+    float paddleX, paddleY;
+    SimBall balls[SIM_MAX_BALLS];   // [0] is the main ball
+    bool extraBallsSpawned;
+
+    int hp;
+    int hpLost;
+    int score;
+    int tick;
+    SimOutcome outcome;
+} SimGame;
+
+bool InitSimGame(SimGame *game, const SimConfig *config, uint32_t seed);
+void FreeSimGame(SimGame *game);
+
+// New level and starting state from seed, reusing the allocation
+void ResetSimGame(SimGame *game, uint32_t seed);
+
+// Advances one fixed tick. The main ball relaunches on its own once lost.
+// Returns the outcome, SIM_RUNNING while the game goes on.
+SimOutcome StepSimGame(SimGame *game, SimAction action);
+
+// Reference paddle AI: follows the lowest ball that is coming down
+SimAction SimChaseAction(const SimGame *game);
+
+#endif // SIM_H
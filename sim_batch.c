@@ -0,0 +1,155 @@
+#include "sim_batch.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool AllocSimBatchResults(SimBatchResults *results, int count) {
+    memset(results, 0, sizeof(*results));
+    if (count <= 0) return false;
+
+    results->seed            = malloc(sizeof(uint32_t) * count);
+    results->ticks           = malloc(sizeof(uint32_t) * count);
+    results->score           = malloc(sizeof(uint32_t) * count);
+    results->hpLost          = malloc(sizeof(uint32_t) * count);
+    results->blocksDestroyed = malloc(sizeof(uint32_t) * count);
+    results->outcome         = malloc(sizeof(uint8_t) * count);
+    if (!results->seed || !results->ticks || !results->score ||
+        !results->hpLost || !results->blocksDestroyed || !results->outcome) {
+        FreeSimBatchResults(results);
+        return false;
+    }
+    results->count = count;
+    return true;
+}
+
+void FreeSimBatchResults(SimBatchResults *results) {
+    free(results->seed);
+    free(results->ticks);
+    free(results->score);
+    free(results->hpLost);
+    free(results->blocksDestroyed);
+    free(results->outcome);
+    memset(results, 0, sizeof(*results));
+}
+
+// ----------------------------------------------------------------------
+//  One job per game
+// ----------------------------------------------------------------------
+typedef struct SimBatch {
+    const SimConfig *config;
+    uint32_t baseSeed;
+    SimPolicyFunc policy;
+    void *policyData;
+    SimBatchResults *results;
+    atomic_bool failed;
+} SimBatch;
+
+static void PlaySimGame(void *userData, int index) {
+    SimBatch *batch = (SimBatch *)userData;
+    SimBatchResults *results = batch->results;
+    uint32_t seed = batch->baseSeed + (uint32_t)index;
+
+    SimGame game;
+    if (!InitSimGame(&game, batch->config, seed)) {
+        atomic_store_explicit(&batch->failed, true, memory_order_relaxed);
+        memset(&game, 0, sizeof(game));
+    }
+    else {
+        while (StepSimGame(&game, batch->policy(&game, batch->policyData)) == SIM_RUNNING) {}
+    }
+
+    results->seed[index]            = seed;
+    results->ticks[index]           = (uint32_t)game.tick;
+    results->score[index]           = (uint32_t)game.score;
+    results->hpLost[index]          = (uint32_t)game.hpLost;
+    results->blocksDestroyed[index] = (uint32_t)(game.startBlocks - game.liveBlocks);
+    results->outcome[index]         = (uint8_t)game.outcome;
+    FreeSimGame(&game);
+}
+
+bool RunSimBatch(JobPool *pool, const SimConfig *config, uint32_t baseSeed,
+                 SimPolicyFunc policy, void *policyData, SimBatchResults *results) {
+    SimBatch batch = { config, baseSeed, policy, policyData, results, false };
+
+    ParallelFor(pool, results->count, PlaySimGame, &batch);
+    return !atomic_load(&batch.failed);
+}
+
+// ----------------------------------------------------------------------
+//  Summary
+// ----------------------------------------------------------------------
+static int CompareUint32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+void PrintSimSpread(const char *label, const uint32_t *values, int count, double scale) {
+    if (count <= 0) {
+        printf("%-16s no games\n", label);
+        return;
+    }
+    uint32_t *sorted = malloc(sizeof(uint32_t) * count);
+    if (!sorted) return;
+    memcpy(sorted, values, sizeof(uint32_t) * count);
+    qsort(sorted, count, sizeof(uint32_t), CompareUint32);
+
+    double sum = 0.0, squares = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum     += sorted[i] * scale;
+        squares += sorted[i] * scale * sorted[i] * scale;
+    }
+    double mean = sum / count;
+    double variance = squares / count - mean * mean;
+    printf("%-16s mean %9.1f   sd %8.1f   p10 %9.1f   p50 %9.1f   p90 %9.1f\n", label,
+           mean, (variance > 0.0) ? sqrt(variance) : 0.0, sorted[count / 10] * scale,
+           sorted[count / 2] * scale, sorted[count * 9 / 10] * scale);
+    free(sorted);
+}
+
+// ----------------------------------------------------------------------
+//  Results file
+// ----------------------------------------------------------------------
+bool WriteSimResults(const char *path, const SimBatchResults *results) {
+    const struct { const char *name; const void *data; uint32_t size; } columns[] = {
+        { "seed",             results->seed,            sizeof(uint32_t) },
+        { "ticks",            results->ticks,           sizeof(uint32_t) },
+        { "score",            results->score,           sizeof(uint32_t) },
+        { "hp_lost",          results->hpLost,          sizeof(uint32_t) },
+        { "destroyed",        results->blocksDestroyed, sizeof(uint32_t) },
+        { "outcome",          results->outcome,         sizeof(uint8_t)  },
+    };
+    const uint32_t columnCount = (uint32_t)(sizeof(columns) / sizeof(columns[0]));
+
+    SimResultsHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SIM_RESULTS_MAGIC, 4);
+    header.version     = SIM_RESULTS_VERSION;
+    header.rowCount    = (uint32_t)results->count;
+    header.columnCount = columnCount;
+
+    SimResultsColumn descs[sizeof(columns) / sizeof(columns[0])];
+    memset(descs, 0, sizeof(descs));
+    uint64_t offset = sizeof(header) + sizeof(descs);
+    for (uint32_t c = 0; c < columnCount; c++) {
+        strncpy(descs[c].name, columns[c].name, sizeof(descs[c].name) - 1);
+        descs[c].elementSize = columns[c].size;
+        descs[c].offset      = offset;
+        offset += (uint64_t)columns[c].size * results->count;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(descs, sizeof(descs), 1, file) == 1;
+    for (uint32_t c = 0; ok && c < columnCount; c++) {
+        ok = fwrite(columns[c].data, columns[c].size, (size_t)results->count, file) == (size_t)results->count;
+    }
+
+    if (fclose(file) != 0) ok = false;
+    return ok;
+}
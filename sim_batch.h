@@ -0,0 +1,68 @@
+#ifndef SIM_BATCH_H
+#define SIM_BATCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sim.h"
+#include "job_pool.h"
+
+#define SIM_RESULTS_MAGIC   "BKSR"
+#define SIM_RESULTS_VERSION 1
+
+// Picks the paddle move for the current tick
+typedef SimAction (*SimPolicyFunc)(const SimGame *game, void *userData);
+
+// ----------------------------------------------------------------------
+//  One row per game, stored as columns so each statistic is a plain
+//  array: cheap to aggregate here and written out as is
+// ----------------------------------------------------------------------
+typedef struct SimBatchResults {
+    int count;
+    uint32_t *seed;
+    uint32_t *ticks;
+    uint32_t *score;
+    uint32_t *hpLost;
+    uint32_t *blocksDestroyed;
+    uint8_t  *outcome;       // SimOutcome
+} SimBatchResults;
+
+bool AllocSimBatchResults(SimBatchResults *results, int count);
+void FreeSimBatchResults(SimBatchResults *results);
+
+// Plays games [0, count) to the end on the pool, game i seeded with
+// baseSeed + i. Every game owns its state, so any thread can take any
+// game, and finished threads keep pulling the next one until none are
+// left. policy is called concurrently and must not share mutable state.
+bool RunSimBatch(JobPool *pool, const SimConfig *config, uint32_t baseSeed,
+                 SimPolicyFunc policy, void *policyData, SimBatchResults *results);
+
+// Prints mean, standard deviation and the 10th/50th/90th percentiles of
+// count values, each multiplied by scale. Sorts a copy, so the values
+// keep their game order.
+void PrintSimSpread(const char *label, const uint32_t *values, int count, double scale);
+
+// ----------------------------------------------------------------------
+//  Results file (.bksr)
+//
+//  [SimResultsHeader][SimResultsColumn x columnCount][column data ...]
+//
+//  Little-endian. Each column is rowCount values of its element size,
+//  starting at its offset, so a reader can map or slice any one of them.
+// ----------------------------------------------------------------------
+typedef struct SimResultsHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t rowCount;
+    uint32_t columnCount;
+} SimResultsHeader;
+
+typedef struct SimResultsColumn {
+    char     name[16];       // NUL padded
+    uint32_t elementSize;    // bytes per value, all unsigned integers
+    uint32_t reserved;
+    uint64_t offset;         // from the start of the file
+} SimResultsColumn;
+
+bool WriteSimResults(const char *path, const SimBatchResults *results);
+
+#endif // SIM_BATCH_H
@@ -0,0 +1,161 @@
+#include "sim_channel.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static uint64_t AlignUp(uint64_t size) {
+    return (size + SIM_CHANNEL_ALIGN - 1) & ~(uint64_t)(SIM_CHANNEL_ALIGN - 1);
+}
+
+static uint64_t HeaderSize(void) {
+    return AlignUp(sizeof(SimChannelHeader));
+}
+
+static bool AttachMapping(SimChannel *channel, const char *name) {
+    channel->header = (SimChannelHeader *)channel->mapping.data;
+    channel->slots  = (unsigned char *)channel->mapping.data + HeaderSize();
+    snprintf(channel->name, sizeof(channel->name), "%s", name);
+    return true;
+}
+
+// ----------------------------------------------------------------------
+//  Lifetime
+// ----------------------------------------------------------------------
+bool CreateSimChannel(SimChannel *channel, const char *name, int envCount, int observationSize, int slotCount) {
+    memset(channel, 0, sizeof(*channel));
+    if (envCount <= 0 || observationSize <= 0 || slotCount <= 0) return false;
+
+    uint64_t observationBytes = AlignUp((uint64_t)envCount * observationSize * sizeof(float));
+    uint64_t rewardBytes      = AlignUp((uint64_t)envCount * sizeof(float));
+    uint64_t flagBytes        = AlignUp((uint64_t)envCount);
+    uint64_t slotSize         = observationBytes + rewardBytes + flagBytes * 2;
+    uint64_t totalSize        = HeaderSize() + slotSize * slotCount;
+
+    // A region left behind by a host that died would keep its old counters
+    RemoveSharedMemory(name);
+    if (!MapSharedMemory(name, (size_t)totalSize, true, &channel->mapping)) return false;
+    AttachMapping(channel, name);
+    channel->owner = true;
+
+    SimChannelHeader *header = channel->header;
+    memset(header, 0, sizeof(*header));
+    header->version         = SIM_CHANNEL_VERSION;
+    header->envCount        = (uint32_t)envCount;
+    header->observationSize = (uint32_t)observationSize;
+    header->slotCount       = (uint32_t)slotCount;
+    header->totalSize       = totalSize;
+    header->slotSize        = slotSize;
+    header->rewardsOffset   = observationBytes;
+    header->donesOffset     = observationBytes + rewardBytes;
+    header->actionsOffset   = observationBytes + rewardBytes + flagBytes;
+    atomic_init(&header->published, 0);
+    atomic_init(&header->acted, 0);
+    atomic_init(&header->closed, 0);
+    atomic_init(&header->trainerClosed, 0);
+
+    // Magic last: a trainer that opens early sees no channel rather than half of one
+    atomic_thread_fence(memory_order_release);
+    memcpy(header->magic, SIM_CHANNEL_MAGIC, 4);
+    return true;
+}
+
+bool OpenSimChannel(SimChannel *channel, const char *name) {
+    memset(channel, 0, sizeof(*channel));
+
+    // The header says how big the whole thing is
+    MappedFile probe;
+    if (!MapSharedMemory(name, sizeof(SimChannelHeader), false, &probe)) return false;
+    const SimChannelHeader *header = (const SimChannelHeader *)probe.data;
+    bool valid = memcmp(header->magic, SIM_CHANNEL_MAGIC, 4) == 0;
+    // Pairs with the release fence before the host wrote the magic
+    atomic_thread_fence(memory_order_acquire);
+    valid = valid && header->version == SIM_CHANNEL_VERSION;
+    uint64_t totalSize = header->totalSize;
+    UnmapFile(&probe);
+    if (!valid) return false;
+
+    if (!MapSharedMemory(name, (size_t)totalSize, false, &channel->mapping)) return false;
+    return AttachMapping(channel, name);
+}
+
+void CloseSimChannel(SimChannel *channel) {
+    if (!channel->header) return;
+
+    // Bumping the words as well means a side about to sleep on one never
+    // misses the close: its futex sees a changed value and returns
+    if (channel->owner) {
+        atomic_store_explicit(&channel->header->closed, 1, memory_order_release);
+        atomic_fetch_add(&channel->header->published, 1);
+        atomic_fetch_add(&channel->header->acted, 1);
+        WakeSharedWord(&channel->header->published);
+        WakeSharedWord(&channel->header->acted);
+    } else {
+        // A host waiting on actions that will never come
+        atomic_store_explicit(&channel->header->trainerClosed, 1, memory_order_release);
+        atomic_fetch_add(&channel->header->acted, 1);
+        WakeSharedWord(&channel->header->acted);
+    }
+    UnmapFile(&channel->mapping);
+    if (channel->owner) RemoveSharedMemory(channel->name);
+    memset(channel, 0, sizeof(*channel));
+}
+
+// ----------------------------------------------------------------------
+//  Slot regions
+// ----------------------------------------------------------------------
+static unsigned char *SlotFor(const SimChannel *channel, uint32_t step) {
+    return channel->slots + (uint64_t)(step % channel->header->slotCount) * channel->header->slotSize;
+}
+
+float *SimChannelObservations(const SimChannel *channel, uint32_t step) {
+    return (float *)SlotFor(channel, step);
+}
+
+float *SimChannelRewards(const SimChannel *channel, uint32_t step) {
+    return (float *)(SlotFor(channel, step) + channel->header->rewardsOffset);
+}
+
+uint8_t *SimChannelDones(const SimChannel *channel, uint32_t step) {
+    return SlotFor(channel, step) + channel->header->donesOffset;
+}
+
+uint8_t *SimChannelActions(const SimChannel *channel, uint32_t step) {
+    return SlotFor(channel, step) + channel->header->actionsOffset;
+}
+
+// ----------------------------------------------------------------------
+//  Handoff
+// ----------------------------------------------------------------------
+static void Advance(_Atomic uint32_t *word, uint32_t step) {
+    atomic_store_explicit(word, step + 1, memory_order_release);
+    WakeSharedWord(word);
+}
+
+// Counters wrap, so "reached" is a signed distance
+static bool WaitForCount(SimChannel *channel, _Atomic uint32_t *word, uint32_t target) {
+    for (int spin = 0;; spin++) {
+        // Value first: a close bumps the word after setting its flag, so a
+        // count reached that way is always seen as the close it is
+        uint32_t value = atomic_load_explicit(word, memory_order_acquire);
+        if (atomic_load_explicit(&channel->header->closed, memory_order_acquire)) return false;
+        if (atomic_load_explicit(&channel->header->trainerClosed, memory_order_acquire)) return false;
+        if ((int32_t)(value - target) >= 0) return true;
+        if (spin >= SIM_CHANNEL_SPIN) WaitOnSharedWord(word, value);
+    }
+}
+
+void PublishSimStep(SimChannel *channel, uint32_t step) {
+    Advance(&channel->header->published, step);
+}
+
+void SubmitSimActions(SimChannel *channel, uint32_t step) {
+    Advance(&channel->header->acted, step);
+}
+
+bool WaitForSimStep(SimChannel *channel, uint32_t step) {
+    return WaitForCount(channel, &channel->header->published, step + 1);
+}
+
+bool WaitForSimActions(SimChannel *channel, uint32_t step) {
+    return WaitForCount(channel, &channel->header->acted, step + 1);
+}
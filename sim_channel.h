@@ -0,0 +1,81 @@
+#ifndef SIM_CHANNEL_H
+#define SIM_CHANNEL_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "platform.h"
+
+#define SIM_CHANNEL_MAGIC   "BKCH"
+#define SIM_CHANNEL_VERSION 2
+#define SIM_CHANNEL_ALIGN   64      // every region starts on its own cache line
+#define SIM_CHANNEL_SPIN    4096    // polls before going to sleep on the word
+
+// ----------------------------------------------------------------------
+//  Shared-memory channel between an environment host and a trainer in
+//  another process
+//
+//  [SimChannelHeader][slot 0][slot 1]...
+//  Each slot holds, for every environment, the observation row, reward and
+//  done flag of one step and the action the trainer picked for it. Step k
+//  lives in slot k % slotCount. The host steps the environment straight
+//  into the slot, so nothing is serialized or copied on the way.
+//
+//  Two counters hand the steps back and forth, each one a futex word:
+//    published  host: observations of steps < published are in
+//    acted      trainer: actions for steps < acted are in
+//  With one slot the host overwrites the observations in place, which
+//  lets the environment rewrite only what changed. With more, a trainer
+//  can keep the last few steps around while the next one runs.
+// ----------------------------------------------------------------------
+typedef struct SimChannelHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t envCount;
+    uint32_t observationSize;   // floats per environment
+    uint32_t slotCount;
+    uint32_t reserved;
+    uint64_t totalSize;         // bytes of the whole mapping
+    uint64_t slotSize;          // bytes per slot
+    uint64_t rewardsOffset;     // within a slot, float per environment
+    uint64_t donesOffset;       // uint8 per environment
+    uint64_t actionsOffset;     // uint8 (SimAction) per environment
+
+    _Alignas(SIM_CHANNEL_ALIGN) _Atomic uint32_t published;
+    _Alignas(SIM_CHANNEL_ALIGN) _Atomic uint32_t acted;
+    _Alignas(SIM_CHANNEL_ALIGN) _Atomic uint32_t closed;          // set by the host
+    _Alignas(SIM_CHANNEL_ALIGN) _Atomic uint32_t trainerClosed;   // set by the trainer
+} SimChannelHeader;
+
+typedef struct SimChannel {
+    MappedFile mapping;
+    SimChannelHeader *header;
+    unsigned char *slots;
+    char name[64];
+    bool owner;                 // the host removes the name when it closes
+} SimChannel;
+
+// Host side: creates the named region, replacing any left over
+bool CreateSimChannel(SimChannel *channel, const char *name, int envCount, int observationSize, int slotCount);
+
+// Trainer side: maps a region the host created
+bool OpenSimChannel(SimChannel *channel, const char *name);
+
+// Either side's close marks the channel closed and wakes the other one
+void CloseSimChannel(SimChannel *channel);
+
+float   *SimChannelObservations(const SimChannel *channel, uint32_t step);
+float   *SimChannelRewards(const SimChannel *channel, uint32_t step);
+uint8_t *SimChannelDones(const SimChannel *channel, uint32_t step);
+uint8_t *SimChannelActions(const SimChannel *channel, uint32_t step);
+
+// Host: step's observations are written. Trainer: step's actions are.
+void PublishSimStep(SimChannel *channel, uint32_t step);
+void SubmitSimActions(SimChannel *channel, uint32_t step);
+
+// Spin briefly, then sleep until the other side gets to step. Return
+// false if the channel was closed instead.
+bool WaitForSimStep(SimChannel *channel, uint32_t step);
+bool WaitForSimActions(SimChannel *channel, uint32_t step);
+
+#endif // SIM_CHANNEL_H
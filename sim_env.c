@@ -0,0 +1,159 @@
+#include "sim_env.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_ENV_HEADER 3            // paddle x, HP, score
+#define SIM_ENV_BLOCKS (SIM_ENV_HEADER + SIM_MAX_BALLS * SIM_ENV_BALL_FEATURES)
+
+static uint32_t EpisodeSeed(const SimEnv *env, int index) {
+    return env->seed + (uint32_t)index + env->episodes[index] * (uint32_t)env->count;
+}
+
+// ----------------------------------------------------------------------
+//  Observation rows
+// ----------------------------------------------------------------------
+static void WriteDynamicState(const SimEnv *env, const SimGame *game, float *row) {
+    row[0] = game->paddleX / SIM_SCREEN_WIDTH;
+    row[1] = (float)game->hp / env->config.startHP;
+    row[2] = (game->startBlocks > 0) ? (float)game->score / (game->startBlocks * 100) : 0.0f;
+
+    float *ball = row + SIM_ENV_HEADER;
+    for (int i = 0; i < SIM_MAX_BALLS; i++, ball += SIM_ENV_BALL_FEATURES) {
+        const SimBall *b = &game->balls[i];
+        ball[0] = b->x / SIM_SCREEN_WIDTH;
+        ball[1] = b->y / SIM_SCREEN_HEIGHT;
+        ball[2] = b->vx / SIM_BALL_SPEED;
+        ball[3] = b->vy / SIM_BALL_SPEED;
+        ball[4] = b->active ? 1.0f : 0.0f;
+    }
+}
+
+static void WriteFullRow(const SimEnv *env, const SimGame *game, float *row) {
+    WriteDynamicState(env, game, row);
+    float *blocks = row + SIM_ENV_BLOCKS;
+    for (int i = 0; i < game->blockCount; i++) blocks[i] = game->health[i] * (1.0f / 3.0f);
+}
+
+// ----------------------------------------------------------------------
+//  Lifetime
+// ----------------------------------------------------------------------
+// A fixed layout with no blocks would be over before it started, every step
+static bool HasLiveCell(const SimConfig *config) {
+    if (!config->layout) return true;
+    for (int i = 0; i < config->rows * config->cols; i++) {
+        if (config->layout[i] > 0) return true;
+    }
+    return false;
+}
+
+SimEnv *CreateSimEnv(int count, const SimConfig *config, uint32_t seed, int threads) {
+    if (count <= 0 || config->rows <= 0 || config->cols <= 0 || config->startHP <= 0 ||
+        !HasLiveCell(config)) return NULL;
+
+    SimEnv *env = calloc(1, sizeof(SimEnv));
+    if (!env) return NULL;
+    env->config          = *config;
+    env->seed            = seed;
+    env->observationSize = SIM_ENV_BLOCKS + config->rows * config->cols;
+
+    // The pool goes first, so DestroySimEnv can always shut it down
+    bool ok = InitJobPool(&env->pool, threads);
+    env->games    = calloc(count, sizeof(SimGame));
+    env->episodes = calloc(count, sizeof(uint32_t));
+    if (!ok || !env->games || !env->episodes) {
+        DestroySimEnv(env);
+        return NULL;
+    }
+
+    for (; env->count < count; env->count++) {
+        if (!InitSimGame(&env->games[env->count], config, EpisodeSeed(env, env->count))) {
+            DestroySimEnv(env);
+            return NULL;
+        }
+    }
+    return env;
+}
+
+void DestroySimEnv(SimEnv *env) {
+    if (!env) return;
+    for (int i = 0; i < env->count; i++) FreeSimGame(&env->games[i]);
+    ShutdownJobPool(&env->pool);
+    free(env->games);
+    free(env->episodes);
+    free(env);
+}
+
+int SimEnvObservationSize(const SimEnv *env) {
+    return env->observationSize;
+}
+
+// ----------------------------------------------------------------------
+//  Reset / step, SIM_ENV_CHUNK games per job
+// ----------------------------------------------------------------------
+static void ResetChunk(void *userData, int chunk) {
+    SimEnv *env = (SimEnv *)userData;
+    int end = (chunk + 1) * SIM_ENV_CHUNK;
+    if (end > env->count) end = env->count;
+
+    for (int i = chunk * SIM_ENV_CHUNK; i < end; i++) {
+        env->episodes[i] = 0;
+        ResetSimGame(&env->games[i], EpisodeSeed(env, i));
+        WriteFullRow(env, &env->games[i], env->observations + (size_t)i * env->observationSize);
+    }
+}
+
+static void StepChunk(void *userData, int chunk) {
+    SimEnv *env = (SimEnv *)userData;
+    int end = (chunk + 1) * SIM_ENV_CHUNK;
+    if (end > env->count) end = env->count;
+    bool incremental = (env->observations == env->lastObservations);
+
+    for (int i = chunk * SIM_ENV_CHUNK; i < end; i++) {
+        SimGame *game = &env->games[i];
+        float *row    = env->observations + (size_t)i * env->observationSize;
+        int score     = game->score;
+        int hpLost    = game->hpLost;
+
+        SimAction action = (env->actions[i] < SIM_ACTION_COUNT) ? (SimAction)env->actions[i] : SIM_MOVE_NONE;
+        bool done = StepSimGame(game, action) != SIM_RUNNING;
+        env->rewards[i] = (float)((game->score - score) / 100 - (game->hpLost - hpLost));
+        env->dones[i]   = done;
+
+        if (done) {
+            env->episodes[i]++;
+            ResetSimGame(game, EpisodeSeed(env, i));
+            WriteFullRow(env, game, row);
+        }
+        else if (incremental && game->blastCount == 0) {
+            WriteDynamicState(env, game, row);
+            float *blocks = row + SIM_ENV_BLOCKS;
+            for (int h = 0; h < game->hitCount; h++) {
+                int block = game->hitBlocks[h];
+                blocks[block] = game->health[block] * (1.0f / 3.0f);
+            }
+        }
+        else {
+            WriteFullRow(env, game, row);
+        }
+    }
+}
+
+static int ChunkCount(const SimEnv *env) {
+    return (env->count + SIM_ENV_CHUNK - 1) / SIM_ENV_CHUNK;
+}
+
+void ResetSimEnv(SimEnv *env, float *observations) {
+    env->observations = observations;
+    ParallelFor(&env->pool, ChunkCount(env), ResetChunk, env);
+    env->lastObservations = observations;
+}
+
+void StepSimEnv(SimEnv *env, const uint8_t *actions, float *observations, float *rewards, uint8_t *dones) {
+    env->actions      = actions;
+    env->observations = observations;
+    env->rewards      = rewards;
+    env->dones        = dones;
+    ParallelFor(&env->pool, ChunkCount(env), StepChunk, env);
+    env->lastObservations = observations;
+}
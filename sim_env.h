@@ -0,0 +1,73 @@
+#ifndef SIM_ENV_H
+#define SIM_ENV_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sim.h"
+#include "job_pool.h"
+
+#if defined(_WIN32) && defined(SIM_ENV_BUILD)
+    #define SIM_ENV_API __declspec(dllexport)
+#elif defined(_WIN32) && defined(SIM_ENV_SHARED)
+    #define SIM_ENV_API __declspec(dllimport)
+#else
+    #define SIM_ENV_API
+#endif
+
+#define SIM_ENV_CHUNK         64    // environments stepped per job
+#define SIM_ENV_BALL_FEATURES 5     // x, y, vx, vy, active
+
+// ----------------------------------------------------------------------
+//  Batch of headless games behind a reset/step interface, for training
+//  paddle agents
+//
+//  Observations are floats, one row of SimEnvObservationSize per game,
+//  written straight into the caller's buffer:
+//    paddle x, HP left, score, SIM_MAX_BALLS x (x, y, vx, vy, active),
+//    then one health per block (0 once destroyed). Positions are scaled by
+//    the screen size, speeds by the ball speed, HP by the starting HP,
+//    score by the level's full score and health by 3.
+//  Passing the same buffer to every step lets a game rewrite only the
+//  blocks it hit (all of them after an explosion), so leave it alone
+//  between steps.
+//
+//  Actions are one SimAction byte per game. The reward is blocks
+//  destroyed minus balls lost during the step. A game that finishes
+//  reports done and starts its next episode at once; its row already
+//  holds the first observation of that episode.
+//
+//  Handles rather than caller-owned structs, so bindings from other
+//  languages never depend on the layout.
+// ----------------------------------------------------------------------
+typedef struct SimEnv {
+    SimConfig config;
+    int count;
+    int observationSize;
+    uint32_t seed;
+    SimGame *games;
+    uint32_t *episodes;      // per game, picks the next episode's seed
+    JobPool pool;
+
+    // Arguments of the call in flight, read by the jobs
+    const uint8_t *actions;
+    float *observations;
+    float *rewards;
+    uint8_t *dones;
+    const float *lastObservations;  // buffer the previous call wrote
+} SimEnv;
+
+// threads as for InitJobPool: < 0 one per CPU, 0 the calling thread only.
+// NULL for bad sizes, or a layout without a single block.
+SIM_ENV_API SimEnv *CreateSimEnv(int count, const SimConfig *config, uint32_t seed, int threads);
+SIM_ENV_API void DestroySimEnv(SimEnv *env);
+
+SIM_ENV_API int SimEnvObservationSize(const SimEnv *env);
+
+// observations: count * SimEnvObservationSize floats
+SIM_ENV_API void ResetSimEnv(SimEnv *env, float *observations);
+
+// actions, rewards and dones: count entries each
+SIM_ENV_API void StepSimEnv(SimEnv *env, const uint8_t *actions, float *observations,
+                            float *rewards, uint8_t *dones);
+
+#endif // SIM_ENV_H
@@ -0,0 +1,56 @@
+#include "snapshot.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SNAPSHOT_MIN_CAPACITY 4096
+
+void FreeSnapshot(Snapshot *snapshot) {
+    free(snapshot->data);
+    memset(snapshot, 0, sizeof(*snapshot));
+}
+
+void BeginSnapshotWrite(Snapshot *snapshot) {
+    snapshot->size   = 0;
+    snapshot->cursor = 0;
+}
+
+void *ReserveSnapshot(Snapshot *snapshot, size_t size) {
+    if (!snapshot->data || size > snapshot->capacity - snapshot->size) {
+        size_t capacity = snapshot->capacity ? snapshot->capacity : SNAPSHOT_MIN_CAPACITY;
+        while (capacity - snapshot->size < size) capacity *= 2;
+
+        unsigned char *grown = realloc(snapshot->data, capacity);
+        if (!grown) return NULL;
+        snapshot->data     = grown;
+        snapshot->capacity = capacity;
+    }
+    void *bytes = snapshot->data + snapshot->size;
+    snapshot->size += size;
+    return bytes;
+}
+
+bool WriteSnapshot(Snapshot *snapshot, const void *data, size_t size) {
+    void *bytes = ReserveSnapshot(snapshot, size);
+    if (!bytes) return false;
+    if (size > 0) memcpy(bytes, data, size);
+    return true;
+}
+
+void BeginSnapshotRead(Snapshot *snapshot) {
+    snapshot->cursor = 0;
+}
+
+const void *TakeSnapshotBytes(Snapshot *snapshot, size_t size) {
+    if (size > snapshot->size - snapshot->cursor) return NULL;
+    const void *bytes = snapshot->data + snapshot->cursor;
+    snapshot->cursor += size;
+    return bytes;
+}
+
+bool ReadSnapshot(Snapshot *snapshot, void *data, size_t size) {
+    const void *bytes = TakeSnapshotBytes(snapshot, size);
+    if (!bytes) return false;
+    if (size > 0) memcpy(data, bytes, size);
+    return true;
+}
@@ -0,0 +1,38 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// ----------------------------------------------------------------------
+//  Byte buffer for game state snapshots
+//
+//  Written front to back and read back in the same order. The memory is
+//  kept between snapshots and only grows, so a ring of them for rewind or
+//  rollback stops allocating once each has held its largest state. Values
+//  are stored in host byte order: a snapshot is for the machine and build
+//  that took it.
+// ----------------------------------------------------------------------
+typedef struct Snapshot {
+    unsigned char *data;
+    size_t size;             // bytes written
+    size_t capacity;
+    size_t cursor;           // next byte to read
+} Snapshot;
+
+void FreeSnapshot(Snapshot *snapshot);
+
+void BeginSnapshotWrite(Snapshot *snapshot);        // empties it, keeps the memory
+bool WriteSnapshot(Snapshot *snapshot, const void *data, size_t size);
+
+// Appends size bytes to fill in place, or NULL if out of memory. The
+// pointer is good until the next write.
+void *ReserveSnapshot(Snapshot *snapshot, size_t size);
+
+void BeginSnapshotRead(Snapshot *snapshot);
+bool ReadSnapshot(Snapshot *snapshot, void *data, size_t size);
+
+// Points at the next size bytes and skips them, or NULL if there are fewer
+const void *TakeSnapshotBytes(Snapshot *snapshot, size_t size);
+
+#endif // SNAPSHOT_H
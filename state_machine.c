@@ -0,0 +1,92 @@
+#include "state_machine.h"
+
+#include <string.h>
+#include "raylib.h"
+#include "platform.h"
+
+void InitStateMachine(StateMachine *machine, const StateDesc *states, int stateCount) {
+    memset(machine, 0, sizeof(*machine));
+    memset(machine->transitions, -1, sizeof(machine->transitions));
+    machine->states       = states;
+    machine->stateCount   = (stateCount < SM_MAX_STATES) ? stateCount : SM_MAX_STATES;
+    machine->pendingEvent = SM_NO_EVENT;
+}
+
+void AddStateTransition(StateMachine *machine, int from, int event, int to) {
+    if (from < 0 || from >= machine->stateCount || to < 0 || to >= machine->stateCount) return;
+    if (event < 0 || event >= SM_MAX_EVENTS) return;
+    machine->transitions[from][event] = (int8_t)to;
+}
+
+// ----------------------------------------------------------------------
+//  Transitions, timed so slow enter/exit hooks show up in the log
+// ----------------------------------------------------------------------
+static void EnterState(StateMachine *machine, int state, double start) {
+    const StateDesc *desc = &machine->states[state];
+    if (desc->enter) desc->enter();
+
+    double now = NowSeconds();
+    StateStats *stats = &machine->stats[state];
+    stats->entries++;
+    stats->lastTransitionMs = (now - start) * 1000.0;
+    if (stats->lastTransitionMs > stats->maxTransitionMs) stats->maxTransitionMs = stats->lastTransitionMs;
+
+    machine->current   = state;
+    machine->enteredAt = now;
+}
+
+void StartStateMachine(StateMachine *machine, int initialState) {
+    EnterState(machine, initialState, NowSeconds());
+}
+
+void SendStateEvent(StateMachine *machine, int event) {
+    machine->pendingEvent = event;
+}
+
+static void ApplyPendingEvent(StateMachine *machine) {
+    int event = machine->pendingEvent;
+    machine->pendingEvent = SM_NO_EVENT;
+    if (event < 0 || event >= SM_MAX_EVENTS) return;
+
+    int from = machine->current;
+    int to   = machine->transitions[from][event];
+    if (to < 0) return;
+
+    double start = NowSeconds();
+    machine->stats[from].timeInState += start - machine->enteredAt;
+    if (machine->states[from].exit) machine->states[from].exit();
+    EnterState(machine, to, start);
+
+    TraceLog(LOG_INFO, "STATE: %s -> %s (%.3f ms)", machine->states[from].name,
+             machine->states[to].name, machine->stats[to].lastTransitionMs);
+}
+
+// ----------------------------------------------------------------------
+//  Per-frame hooks
+// ----------------------------------------------------------------------
+void UpdateStateMachine(StateMachine *machine) {
+    ApplyPendingEvent(machine);
+
+    const StateDesc *desc = &machine->states[machine->current];
+    if (desc->update) desc->update();
+}
+
+void DrawStateMachine(const StateMachine *machine) {
+    const StateDesc *desc = &machine->states[machine->current];
+    if (desc->draw) desc->draw();
+}
+
+const StateStats *GetStateStats(const StateMachine *machine, int state) {
+    return &machine->stats[state];
+}
+
+void LogStateMachineStats(const StateMachine *machine) {
+    for (int state = 0; state < machine->stateCount; state++) {
+        const StateStats *stats = &machine->stats[state];
+        double timeInState = stats->timeInState;
+        if (state == machine->current) timeInState += NowSeconds() - machine->enteredAt;
+
+        TraceLog(LOG_INFO, "STATE: %-10s entered %u times, %.1f s total, transition max %.3f ms",
+                 machine->states[state].name, stats->entries, timeInState, stats->maxTransitionMs);
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef STATE_MACHINE_H
+#define STATE_MACHINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SM_MAX_STATES 8
+#define SM_MAX_EVENTS 8
+#define SM_NO_EVENT   (-1)
+
+typedef void (*StateHook)(void);
+
+// Any hook may be NULL. update runs before BeginDrawing, draw inside it.
+typedef struct StateDesc {
+    const char *name;
+    StateHook enter;
+    StateHook exit;
+    StateHook update;
+    StateHook draw;
+} StateDesc;
+
+typedef struct StateStats {
+    uint32_t entries;
+    double timeInState;          // seconds, summed over all visits
+    double lastTransitionMs;     // exit of the old state + enter of this one
+    double maxTransitionMs;
+} StateStats;
+
+// ----------------------------------------------------------------------
+//  Table-driven state machine
+//
+//  Events raised during a frame are queued and applied at the start of the
+//  next one, so a state's update and draw always see the same state.
+// ----------------------------------------------------------------------
+typedef struct StateMachine {
+    const StateDesc *states;
+    int stateCount;
+    int8_t transitions[SM_MAX_STATES][SM_MAX_EVENTS];   // -1: event ignored
+    int current;
+    int pendingEvent;
+    double enteredAt;
+    StateStats stats[SM_MAX_STATES];
+} StateMachine;
+
+void InitStateMachine(StateMachine *machine, const StateDesc *states, int stateCount);
+void AddStateTransition(StateMachine *machine, int from, int event, int to);
+
+// Runs the enter hook of the first state.
+void StartStateMachine(StateMachine *machine, int initialState);
+
+// Only the last event of a frame is kept, which is all the game needs.
+void SendStateEvent(StateMachine *machine, int event);
+
+void UpdateStateMachine(StateMachine *machine);
+void DrawStateMachine(const StateMachine *machine);
+
+const StateStats *GetStateStats(const StateMachine *machine, int state);
+void LogStateMachineStats(const StateMachine *machine);
+
+#endif // STATE_MACHINE_H
@@ -0,0 +1,219 @@
+#include "timer_wheel.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "checksum.h"
+
+#define TIMER_LIST_FIRING  (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS)
+#define TIMER_LIST_FREE    0xFFFF
+#define TIMER_INDEX_MASK   0xFFFFFFu
+#define TIMER_MAX_CAPACITY ((int)TIMER_INDEX_MASK)
+
+static TimerId MakeTimerId(int index, uint8_t generation) {
+    return ((TimerId)generation << 24) | (TimerId)(index + 1);
+}
+
+// Node index of a live id, or -1
+static int TimerIndex(const TimerWheel *wheel, TimerId timer) {
+    int index = (int)(timer & TIMER_INDEX_MASK) - 1;
+    if (index < 0 || index >= wheel->capacity) return -1;
+
+    const TimerNode *node = &wheel->nodes[index];
+    if (node->list == TIMER_LIST_FREE || node->generation != (uint8_t)(timer >> 24)) return -1;
+    return index;
+}
+
+// A pending timer's share of the digest. Summed rather than hashed in
+// sequence, since the wheel's order is not kept across a save and restore.
+static uint32_t DigestTerm(const TimerNode *node) {
+    TimerRecord record = { node->expires, node->kind, node->arg };
+    return Hash32(0, &record, sizeof(record));
+}
+
+// An empty wheel with no pool: scheduling fails, advancing only moves the clock
+static void ResetTimerWheel(TimerWheel *wheel) {
+    memset(wheel, 0, sizeof(*wheel));
+    wheel->freeHead = -1;
+    for (int i = 0; i <= TIMER_LIST_FIRING; i++) wheel->heads[i] = -1;
+}
+
+bool InitTimerWheel(TimerWheel *wheel, int capacity) {
+    ResetTimerWheel(wheel);
+    if (capacity <= 0 || capacity > TIMER_MAX_CAPACITY) return false;
+
+    wheel->nodes = malloc(sizeof(TimerNode) * capacity);
+    if (!wheel->nodes) return false;
+    wheel->capacity = capacity;
+
+    for (int i = 0; i < capacity; i++) {
+        wheel->nodes[i].next       = (i + 1 < capacity) ? i + 1 : -1;
+        wheel->nodes[i].list       = TIMER_LIST_FREE;
+        wheel->nodes[i].generation = 0;
+    }
+    wheel->freeHead = 0;
+    return true;
+}
+
+void FreeTimerWheel(TimerWheel *wheel) {
+    free(wheel->nodes);
+    ResetTimerWheel(wheel);
+}
+
+// ----------------------------------------------------------------------
+//  Slot lists
+// ----------------------------------------------------------------------
+static void LinkNode(TimerWheel *wheel, int index, int list) {
+    TimerNode *node = &wheel->nodes[index];
+    node->list = (uint16_t)list;
+    node->prev = -1;
+    node->next = wheel->heads[list];
+    if (node->next >= 0) wheel->nodes[node->next].prev = index;
+    wheel->heads[list] = index;
+}
+
+static void UnlinkNode(TimerWheel *wheel, int index) {
+    TimerNode *node = &wheel->nodes[index];
+    if (node->prev >= 0) wheel->nodes[node->prev].next = node->next;
+    else                 wheel->heads[node->list] = node->next;
+    if (node->next >= 0) wheel->nodes[node->next].prev = node->prev;
+}
+
+// Level is picked by the highest bit where expiry and now differ, so the
+// slot is always ahead of the wheel's position on that level
+static void PlaceNode(TimerWheel *wheel, int index) {
+    uint64_t expires = wheel->nodes[index].expires;
+    uint64_t differ  = expires ^ wheel->now;
+
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && (differ >> (TIMER_WHEEL_BITS * (level + 1))) != 0) level++;
+
+    int slot = (int)((expires >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1));
+    LinkNode(wheel, index, level * TIMER_WHEEL_SLOTS + slot);
+}
+
+static void ReleaseNode(TimerWheel *wheel, int index) {
+    TimerNode *node = &wheel->nodes[index];
+    node->list = TIMER_LIST_FREE;
+    node->generation++;
+    node->next = wheel->freeHead;
+    wheel->freeHead = index;
+    wheel->pending--;
+    wheel->digest -= DigestTerm(node);
+}
+
+// ----------------------------------------------------------------------
+//  Schedule / cancel
+// ----------------------------------------------------------------------
+TimerId ScheduleTimer(TimerWheel *wheel, uint64_t delay, int kind, int arg) {
+    if (wheel->freeHead < 0) return TIMER_INVALID;
+    if (delay < 1) delay = 1;
+    if (delay > TIMER_WHEEL_MAX_DELAY) delay = TIMER_WHEEL_MAX_DELAY;
+
+    int index = wheel->freeHead;
+    TimerNode *node = &wheel->nodes[index];
+    wheel->freeHead = node->next;
+    wheel->pending++;
+
+    node->expires = wheel->now + delay;
+    node->kind    = kind;
+    node->arg     = arg;
+    wheel->digest += DigestTerm(node);
+    PlaceNode(wheel, index);
+    return MakeTimerId(index, node->generation);
+}
+
+bool CancelTimer(TimerWheel *wheel, TimerId timer) {
+    int index = TimerIndex(wheel, timer);
+    if (index < 0) return false;
+
+    UnlinkNode(wheel, index);
+    ReleaseNode(wheel, index);
+    return true;
+}
+
+bool IsTimerPending(const TimerWheel *wheel, TimerId timer) {
+    return TimerIndex(wheel, timer) >= 0;
+}
+
+// ----------------------------------------------------------------------
+//  Advance
+// ----------------------------------------------------------------------
+// Moves a higher-level slot's timers down now that the wheel has reached it
+static void CascadeSlot(TimerWheel *wheel, int list) {
+    int index = wheel->heads[list];
+    wheel->heads[list] = -1;
+    while (index >= 0) {
+        int next = wheel->nodes[index].next;
+        PlaceNode(wheel, index);
+        index = next;
+    }
+}
+
+int AdvanceTimerWheel(TimerWheel *wheel, uint64_t tick, TimerFunc fire, void *userData) {
+    int fired = 0;
+
+    while (wheel->now < tick) {
+        wheel->now++;
+        uint64_t now = wheel->now;
+
+        // Every 256 ticks the next slot of level 1 comes due, and so on up
+        for (int level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+            if ((now & ((1ull << (TIMER_WHEEL_BITS * level)) - 1)) != 0) break;
+            int slot = (int)((now >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1));
+            CascadeSlot(wheel, level * TIMER_WHEEL_SLOTS + slot);
+        }
+
+        // Take the due slot as a whole, so callbacks scheduling into the
+        // wheel never land in the list being walked. It stays a real list,
+        // so a callback can still cancel a timer that has not fired yet.
+        int slotList = (int)(now & (TIMER_WHEEL_SLOTS - 1));
+        int head = wheel->heads[slotList];
+        if (head < 0) continue;
+        wheel->heads[slotList] = -1;
+        wheel->heads[TIMER_LIST_FIRING] = head;
+        for (int index = head; index >= 0; index = wheel->nodes[index].next) {
+            wheel->nodes[index].list = TIMER_LIST_FIRING;
+        }
+
+        while (wheel->heads[TIMER_LIST_FIRING] >= 0) {
+            int index = wheel->heads[TIMER_LIST_FIRING];
+            TimerNode *node = &wheel->nodes[index];
+            int kind = node->kind;
+            int arg  = node->arg;
+
+            UnlinkNode(wheel, index);
+            ReleaseNode(wheel, index);
+            fire(userData, kind, arg);
+            fired++;
+        }
+    }
+    return fired;
+}
+
+// ----------------------------------------------------------------------
+//  Save / restore
+// ----------------------------------------------------------------------
+int SaveTimers(const TimerWheel *wheel, TimerRecord *records, int capacity) {
+    int count = 0;
+    for (int i = 0; i < wheel->capacity; i++) {
+        const TimerNode *node = &wheel->nodes[i];
+        if (node->list == TIMER_LIST_FREE) continue;
+        if (count < capacity) records[count] = (TimerRecord){ node->expires, node->kind, node->arg };
+        count++;
+    }
+    return count;
+}
+
+void ClearTimerWheel(TimerWheel *wheel, uint64_t now) {
+    for (int i = 0; i <= TIMER_LIST_FIRING; i++) wheel->heads[i] = -1;
+    for (int i = wheel->capacity - 1; i >= 0; i--) {
+        TimerNode *node = &wheel->nodes[i];
+        if (node->list != TIMER_LIST_FREE) node->generation++;
+        node->list = TIMER_LIST_FREE;
+        node->next = (i + 1 < wheel->capacity) ? i + 1 : -1;
+    }
+    wheel->freeHead = (wheel->capacity > 0) ? 0 : -1;
+    wheel->pending  = 0;
+    wheel->digest   = 0;
+    wheel->now      = now;
+}
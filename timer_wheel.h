@@ -0,0 +1,81 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TIMER_WHEEL_LEVELS   4
+#define TIMER_WHEEL_BITS     8
+#define TIMER_WHEEL_SLOTS    (1 << TIMER_WHEEL_BITS)
+// One top-level slot short of the full 32-bit span, so a timer never lands
+// in the top slot the wheel is currently in (it would wait a whole lap)
+#define TIMER_WHEEL_MAX_DELAY (255ull << 24)
+#define TIMER_INVALID        0u
+
+// Slot index in the low 24 bits, generation in the high 8, so cancelling a
+// timer that already fired (and whose slot was reused) does nothing.
+typedef uint32_t TimerId;
+
+// Called for every due timer, with the kind and argument it was scheduled with
+typedef void (*TimerFunc)(void *userData, int kind, int arg);
+
+typedef struct TimerNode {
+    uint64_t expires;        // tick
+    int32_t next;
+    int32_t prev;
+    int32_t kind;
+    int32_t arg;
+    uint16_t list;           // which slot list holds it, TIMER_LIST_FREE when unused
+    uint8_t generation;
+} TimerNode;
+
+// ----------------------------------------------------------------------
+//  Hierarchical timing wheel
+//
+//  Level 0 has one slot per tick for the next 256 ticks, each level above
+//  covers 256 times the span of the one below. Scheduling and cancelling
+//  are O(1) list operations; advancing a tick touches one level 0 slot,
+//  plus one higher slot every 256 ticks, whose timers move down a level.
+//  Nodes come from a pool allocated at init.
+// ----------------------------------------------------------------------
+typedef struct TimerWheel {
+    uint64_t now;            // last tick processed
+    TimerNode *nodes;
+    int capacity;
+    int freeHead;
+    int pending;
+    uint32_t digest;         // sum of a hash of each pending timer's record, for state hashes
+    int32_t heads[TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS + 1];   // last list holds timers being fired
+} TimerWheel;
+
+bool InitTimerWheel(TimerWheel *wheel, int capacity);
+void FreeTimerWheel(TimerWheel *wheel);
+
+// Fires after delay ticks (at least 1). Returns TIMER_INVALID when the pool is full.
+TimerId ScheduleTimer(TimerWheel *wheel, uint64_t delay, int kind, int arg);
+bool CancelTimer(TimerWheel *wheel, TimerId timer);
+bool IsTimerPending(const TimerWheel *wheel, TimerId timer);
+
+// Processes ticks up to and including tick, firing what is due in order.
+// fire may schedule and cancel timers. Returns how many fired.
+int AdvanceTimerWheel(TimerWheel *wheel, uint64_t tick, TimerFunc fire, void *userData);
+
+// ----------------------------------------------------------------------
+//  Saving: pending timers as plain records, for snapshots
+// ----------------------------------------------------------------------
+typedef struct TimerRecord {
+    uint64_t expires;        // tick
+    int32_t kind;
+    int32_t arg;
+} TimerRecord;
+
+// Copies up to capacity pending timers into records. Returns how many are
+// pending, which may be more than it copied.
+int SaveTimers(const TimerWheel *wheel, TimerRecord *records, int capacity);
+
+// Drops every timer (their ids go stale) and moves the clock to now, to
+// schedule saved records again with delay expires - now. Timers due on the
+// same tick may then fire in a different order than they would have.
+void ClearTimerWheel(TimerWheel *wheel, uint64_t now);
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,70 @@
+// ----------------------------------------------------------------------
+//  Plays many headless games with the reference AI paddle and reports
+//  how they went
+//
+//  usage: batch_runner [games] [rows] [cols] [results.bksr] [threads]
+//  threads < 0 (default) uses every CPU. Per-game rows go to the results
+//  file, one column per statistic; the summary goes to stdout.
+// ----------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include "sim_batch.h"
+#include "platform.h"
+
+static SimAction ChasePolicy(const SimGame *game, void *userData) {
+    (void)userData;
+    return SimChaseAction(game);
+}
+
+int main(int argc, char **argv) {
+    int games           = (argc > 1) ? atoi(argv[1]) : 10000;
+    SimConfig config    = { 0 };
+    config.rows         = (argc > 2) ? atoi(argv[2]) : 2;
+    config.cols         = (argc > 3) ? atoi(argv[3]) : 14;
+    const char *outPath = (argc > 4) ? argv[4] : "batch_results.bksr";
+    int threads         = (argc > 5) ? atoi(argv[5]) : -1;
+    config.startHP      = 10;
+    config.maxTicks     = 10 * 60 * SIM_TICK_RATE;     // ten minutes of play
+
+    JobPool pool;
+    SimBatchResults results;
+    if (!InitJobPool(&pool, threads)) {
+        printf("Failed to start the worker threads\n");
+        return 1;
+    }
+    if (!AllocSimBatchResults(&results, games)) {
+        printf("Failed to allocate results for %d games\n", games);
+        ShutdownJobPool(&pool);
+        return 1;
+    }
+
+    printf("%d games of %dx%d blocks on %d threads\n", games, config.rows, config.cols, pool.threadCount + 1);
+    double start = NowSeconds();
+    bool ok = RunSimBatch(&pool, &config, 1, ChasePolicy, NULL, &results);
+    double elapsed = NowSeconds() - start;
+    if (!ok) printf("Some games could not allocate their blocks\n");
+
+    uint64_t totalTicks = 0;
+    int outcomes[SIM_TIMED_OUT + 1] = { 0 };
+    for (int i = 0; i < games; i++) {
+        totalTicks += results.ticks[i];
+        outcomes[results.outcome[i]]++;
+    }
+    printf("%.2f s   %.0f games/s   %.1f M ticks/s\n",
+           elapsed, games / elapsed, totalTicks / elapsed / 1e6);
+    printf("cleared %.1f%%   lost %.1f%%   timed out %.1f%%\n",
+           100.0 * outcomes[SIM_CLEARED] / games, 100.0 * outcomes[SIM_LOST] / games,
+           100.0 * outcomes[SIM_TIMED_OUT] / games);
+    PrintSimSpread("duration (s)", results.ticks, games, 1.0 / SIM_TICK_RATE);
+    PrintSimSpread("score", results.score, games, 1.0);
+    PrintSimSpread("HP lost", results.hpLost, games, 1.0);
+
+    if (!WriteSimResults(outPath, &results)) {
+        printf("Failed to write %s\n", outPath);
+        ok = false;
+    }
+
+    FreeSimBatchResults(&results);
+    ShutdownJobPool(&pool);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,220 @@
+// ----------------------------------------------------------------------
+//  Estimates how hard one level is by letting the autopilot play it
+//  thousands of times
+//
+//  usage: difficulty <level.bklv | seed> [games] [rows] [cols] [threads]
+//  A number picks the level the generator would make from that seed,
+//  rows x cols; anything else is a level file on the standard grid. The
+//  blocks stay the same in every game; the paddle's aim error, launch
+//  directions and extra balls vary with the game seed, so the spread is
+//  down to how the level plays.
+// ----------------------------------------------------------------------
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim_batch.h"
+#include "level.h"
+#include "autopilot.h"
+#include "platform.h"
+
+// A perfect paddle plays a fixed level the same way every time. Be off
+// by up to a fifth of the paddle, a new amount each second, drawn from
+// the game's own seed so every game misses differently but repeatably.
+static float AimError(const SimGame *game) {
+    uint32_t h = game->seed ^ ((uint32_t)(game->tick / SIM_TICK_RATE) * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return ((float)(h & 0xFFFF) / 65535.0f - 0.5f) * 0.4f * SIM_PADDLE_WIDTH;
+}
+
+// ----------------------------------------------------------------------
+//  The game's --autopilot-aim, on a headless game: meet the ball that
+//  lands first and send it at the lowest block left
+// ----------------------------------------------------------------------
+static SimAction AutopilotPolicy(const SimGame *game, void *userData) {
+    (void)userData;
+    float lineY = game->paddleY - SIM_BALL_RADIUS;
+    float bestTime = 0.0f, bestX = 0.0f;
+    bool found = false;
+    for (int i = 0; i < SIM_MAX_BALLS; i++) {
+        const SimBall *ball = &game->balls[i];
+        if (!ball->active || ball->y > lineY) continue;
+        float crossX, time;
+        if (!PredictBallCrossing((Vector2){ ball->x, ball->y }, (Vector2){ ball->vx, ball->vy },
+                                 SIM_BALL_RADIUS, lineY, SIM_SCREEN_WIDTH, &crossX, &time)) continue;
+        if (!found || time < bestTime) {
+            bestTime = time;
+            bestX    = crossX;
+            found    = true;
+        }
+    }
+    if (!found) return SIM_MOVE_NONE;
+
+    // Lowest live block, nearest the landing spot among equals
+    int target = -1;
+    float targetDistance = 0.0f;
+    int cols = game->config.cols;
+    for (int row = game->config.rows - 1; row >= 0 && target < 0; row--) {
+        for (int col = 0; col < cols; col++) {
+            if (game->health[row * cols + col] == 0) continue;
+            float distance = fabsf(LEVEL_GRID_X + col * SIM_CELL_WIDTH + BLOCK_WIDTH / 2.0f - bestX);
+            if (target < 0 || distance < targetDistance) {
+                target         = row * cols + col;
+                targetDistance = distance;
+            }
+        }
+    }
+
+    float goal = bestX - SIM_PADDLE_WIDTH * 0.4f;
+    if (target >= 0) {
+        Vector2 aim = { LEVEL_GRID_X + (target % cols) * SIM_CELL_WIDTH + BLOCK_WIDTH / 2.0f,
+                        LEVEL_GRID_Y + (target / cols) * SIM_CELL_HEIGHT + BLOCK_HEIGHT };
+        goal = AimPaddleX(bestX, lineY, SIM_PADDLE_WIDTH, SIM_BALL_SPEED, aim);
+    }
+    goal += AimError(game);
+
+    float deadband = SIM_PADDLE_SPEED * SIM_DT;
+    if (game->paddleX > goal + deadband) return SIM_MOVE_LEFT;
+    if (game->paddleX < goal - deadband) return SIM_MOVE_RIGHT;
+    return SIM_MOVE_NONE;
+}
+
+// ----------------------------------------------------------------------
+//  Level to play
+// ----------------------------------------------------------------------
+
+// Both return the cells' health followed by their explosive flags, one
+// allocation for config->layout and config->explosive
+
+// The level a seed gives: the sim's own generator, kept from its first reset
+static unsigned char *LayoutFromSeed(SimConfig *config, uint32_t seed) {
+    SimGame game;
+    if (!InitSimGame(&game, config, seed)) return NULL;
+    unsigned char *layout = malloc((size_t)game.blockCount * 2);
+    if (layout) {
+        memcpy(layout, game.health, game.blockCount);
+        memcpy(layout + game.blockCount, game.explosive, game.blockCount);
+    }
+    FreeSimGame(&game);
+    return layout;
+}
+
+// Grid cells from a level file; custom rects have no cells to go in
+static unsigned char *LayoutFromFile(SimConfig *config, const char *path) {
+    LevelData level;
+    if (!LoadCheckedLevelFile(path, &level)) {
+        printf("Failed to load %s\n", path);
+        return NULL;
+    }
+    if ((level.flags & LEVEL_FLAG_CUSTOM_RECTS) || level.rows <= 0 || level.cols <= 0) {
+        printf("%s is not on the standard grid\n", path);
+        UnloadLevel(&level);
+        return NULL;
+    }
+
+    config->rows = level.rows;
+    config->cols = level.cols;
+    int cells = level.rows * level.cols;
+    unsigned char *layout = calloc((size_t)cells * 2, 1);
+    for (int i = 0; layout && i < level.blockCount; i++) {
+        const Block *block = &level.blocks[i];
+        int col = (int)((block->rect.x - LEVEL_GRID_X) / SIM_CELL_WIDTH + 0.5f);
+        int row = (int)((block->rect.y - LEVEL_GRID_Y) / SIM_CELL_HEIGHT + 0.5f);
+        if (!block->active || row < 0 || row >= level.rows || col < 0 || col >= level.cols) continue;
+        int health = block->health;
+        layout[row * level.cols + col] = (unsigned char)((health < 1) ? 1 : (health > 255) ? 255 : health);
+        layout[cells + row * level.cols + col] = (block->type == BLOCK_EXPLOSIVE);
+    }
+    UnloadLevel(&level);
+    return layout;
+}
+
+// ----------------------------------------------------------------------
+//  Report
+// ----------------------------------------------------------------------
+// Copies the rows that match outcome (or all, for outcome < 0)
+static int SelectRows(const SimBatchResults *results, const uint32_t *column, int outcome, uint32_t *out) {
+    int count = 0;
+    for (int i = 0; i < results->count; i++) {
+        if (outcome < 0 || results->outcome[i] == outcome) out[count++] = column[i];
+    }
+    return count;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        printf("usage: difficulty <level.bklv | seed> [games] [rows] [cols] [threads]\n");
+        return 1;
+    }
+    int games        = (argc > 2) ? atoi(argv[2]) : 5000;
+    SimConfig config = { 0 };
+    config.rows      = (argc > 3) ? atoi(argv[3]) : 2;
+    config.cols      = (argc > 4) ? atoi(argv[4]) : 14;
+    int threads      = (argc > 5) ? atoi(argv[5]) : -1;
+    config.startHP   = 10;
+    config.maxTicks  = 10 * 60 * SIM_TICK_RATE;
+    if (games <= 0) games = 1;
+
+    bool isSeed = isdigit((unsigned char)argv[1][0]);
+    unsigned char *layout = isSeed ? LayoutFromSeed(&config, (uint32_t)strtoul(argv[1], NULL, 10))
+                                   : LayoutFromFile(&config, argv[1]);
+    if (!layout) return 1;
+    int cells = config.rows * config.cols;
+    config.layout    = layout;
+    config.explosive = layout + cells;
+
+    int blocks = 0, health = 0, explosives = 0;
+    for (int i = 0; i < cells; i++) {
+        blocks     += (layout[i] != 0);
+        health     += layout[i];
+        explosives += (layout[i] != 0 && config.explosive[i]);
+    }
+
+    JobPool pool;
+    SimBatchResults results;
+    uint32_t *scratch = malloc(sizeof(uint32_t) * games);
+    if (!scratch || !InitJobPool(&pool, threads)) {
+        printf("Failed to start the worker threads\n");
+        free(scratch);
+        free(layout);
+        return 1;
+    }
+    if (!AllocSimBatchResults(&results, games)) {
+        printf("Failed to allocate results for %d games\n", games);
+        ShutdownJobPool(&pool);
+        free(scratch);
+        free(layout);
+        return 1;
+    }
+
+    printf("%s %s: %dx%d, %d blocks (%d explosive), %d hits at most to clear, %d games on %d threads\n",
+           isSeed ? "seed" : "level", argv[1], config.rows, config.cols, blocks, explosives, health,
+           games, pool.threadCount + 1);
+    double start = NowSeconds();
+    bool ok = RunSimBatch(&pool, &config, 1, AutopilotPolicy, NULL, &results);
+    double elapsed = NowSeconds() - start;
+    if (!ok) printf("Some games could not allocate their blocks\n");
+
+    int outcomes[SIM_TIMED_OUT + 1] = { 0 };
+    for (int i = 0; i < games; i++) outcomes[results.outcome[i]]++;
+    printf("%.2f s   %.0f games/s\n", elapsed, games / elapsed);
+    printf("cleared %.1f%%   lost %.1f%%   timed out %.1f%%\n",
+           100.0 * outcomes[SIM_CLEARED] / games, 100.0 * outcomes[SIM_LOST] / games,
+           100.0 * outcomes[SIM_TIMED_OUT] / games);
+
+    PrintSimSpread("clear time (s)", scratch, SelectRows(&results, results.ticks, SIM_CLEARED, scratch),
+                1.0 / SIM_TICK_RATE);
+    PrintSimSpread("HP lost", scratch, SelectRows(&results, results.hpLost, -1, scratch), 1.0);
+    PrintSimSpread("score", scratch, SelectRows(&results, results.score, -1, scratch), 1.0);
+
+    FreeSimBatchResults(&results);
+    ShutdownJobPool(&pool);
+    free(scratch);
+    free(layout);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+// ----------------------------------------------------------------------
+//  Hosts a batch of environments for a trainer in another process
+//
+//  usage: env_server [name] [envs] [rows] [cols] [slots] [steps] [threads]
+//  Creates the shared-memory channel (see sim_channel.h), publishes the
+//  first observations, then for every step waits for the trainer's
+//  actions and steps the environments straight into the next slot.
+//  steps 0 (default) serves until killed.
+// ----------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include "sim_env.h"
+#include "sim_channel.h"
+#include "platform.h"
+
+int main(int argc, char **argv) {
+    const char *name = (argc > 1) ? argv[1] : "/kuzushi_env";
+    int envs         = (argc > 2) ? atoi(argv[2]) : 1024;
+    SimConfig config = { 0 };
+    config.rows      = (argc > 3) ? atoi(argv[3]) : 2;
+    config.cols      = (argc > 4) ? atoi(argv[4]) : 14;
+    int slots        = (argc > 5) ? atoi(argv[5]) : 1;
+    uint32_t steps   = (argc > 6) ? (uint32_t)strtoul(argv[6], NULL, 10) : 0;
+    int threads      = (argc > 7) ? atoi(argv[7]) : -1;
+    config.startHP   = 10;
+    config.maxTicks  = 10 * 60 * SIM_TICK_RATE;
+
+    SimEnv *env = CreateSimEnv(envs, &config, 1, threads);
+    if (!env) {
+        printf("Failed to create %d environments\n", envs);
+        return 1;
+    }
+    SimChannel channel;
+    if (!CreateSimChannel(&channel, name, envs, SimEnvObservationSize(env), slots)) {
+        printf("Failed to create shared memory %s\n", name);
+        DestroySimEnv(env);
+        return 1;
+    }
+    printf("Serving %d environments of %dx%d blocks on %s, %d floats per observation, %d slots\n",
+           envs, config.rows, config.cols, name, SimEnvObservationSize(env), slots);
+
+    ResetSimEnv(env, SimChannelObservations(&channel, 0));
+    PublishSimStep(&channel, 0);
+
+    double start = NowSeconds(), waiting = 0.0;
+    uint32_t step = 0;
+    for (; steps == 0 || step < steps; step++) {
+        double waitStart = NowSeconds();
+        if (!WaitForSimActions(&channel, step)) {
+            printf("Trainer closed the channel after %u steps\n", step);
+            break;
+        }
+        waiting += NowSeconds() - waitStart;
+
+        StepSimEnv(env, SimChannelActions(&channel, step), SimChannelObservations(&channel, step + 1),
+                   SimChannelRewards(&channel, step + 1), SimChannelDones(&channel, step + 1));
+        PublishSimStep(&channel, step + 1);
+
+        if ((step + 1) % 10000 == 0) {
+            double elapsed = NowSeconds() - start;
+            printf("%u steps   %.2f M env-steps/s   %.0f%% waiting on the trainer\n",
+                   step + 1, (double)envs * (step + 1) / elapsed / 1e6, 100.0 * waiting / elapsed);
+        }
+    }
+
+    CloseSimChannel(&channel);
+    DestroySimEnv(env);
+    return 0;
+}
@@ -0,0 +1,269 @@
+#include "trajectory_cache.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_HIT INFINITY
+
+// When a ball moving from p at v first touches rect (grown by radius, so
+// the centre is tested against it), within tMax, or NO_HIT
+static float RayHitsRect(Vector2 p, Vector2 v, Rectangle rect, float radius, float tMax) {
+    float low[2]  = { rect.x - radius, rect.y - radius };
+    float high[2] = { rect.x + rect.width + radius, rect.y + rect.height + radius };
+    float from[2] = { p.x, p.y };
+    float dir[2]  = { v.x, v.y };
+
+    float tNear = 0.0f, tFar = tMax;
+    for (int axis = 0; axis < 2; axis++) {
+        if (dir[axis] == 0.0f) {
+            if (from[axis] < low[axis] || from[axis] > high[axis]) return NO_HIT;
+            continue;
+        }
+        float t1 = (low[axis] - from[axis]) / dir[axis];
+        float t2 = (high[axis] - from[axis]) / dir[axis];
+        if (t1 > t2) { float swap = t1; t1 = t2; t2 = swap; }
+        if (t1 > tNear) tNear = t1;
+        if (t2 < tFar) tFar = t2;
+        if (tNear > tFar) return NO_HIT;
+    }
+    return tNear;
+}
+
+// ----------------------------------------------------------------------
+//  Lifetime
+// ----------------------------------------------------------------------
+bool InitTrajectoryCache(TrajectoryCache *cache, int capacity, const LevelData *level,
+                         float width, float lineY, int maxBounces) {
+    memset(cache, 0, sizeof(*cache));
+    if (capacity <= 0) return false;
+
+    cache->capacity   = capacity;
+    cache->maxBounces = (maxBounces < 1) ? 1 : (maxBounces > TRAJECTORY_MAX_BOUNCES) ? TRAJECTORY_MAX_BOUNCES : maxBounces;
+    cache->width      = width;
+    cache->lineY      = lineY;
+    cache->blockCount = level->blockCount;
+    for (int i = 0; i < level->blockCount; i++) {
+        float bottom = level->blocks[i].rect.y + level->blocks[i].rect.height;
+        if (bottom > cache->blocksBottom) cache->blocksBottom = bottom;
+    }
+
+    int nodes = capacity * TRAJECTORY_MAX_POINTS;
+    cache->paths      = calloc(capacity, sizeof(TrajectoryPath));
+    cache->blockHeads = malloc(sizeof(int) * (level->blockCount > 0 ? level->blockCount : 1));
+    cache->nodeNext   = malloc(sizeof(int) * nodes);
+    cache->nodePrev   = malloc(sizeof(int) * nodes);
+    if (!cache->paths || !cache->blockHeads || !cache->nodeNext || !cache->nodePrev) {
+        FreeTrajectoryCache(cache);
+        return false;
+    }
+    for (int i = 0; i < level->blockCount; i++) cache->blockHeads[i] = -1;
+    return true;
+}
+
+void FreeTrajectoryCache(TrajectoryCache *cache) {
+    free(cache->paths);
+    free(cache->blockHeads);
+    free(cache->nodeNext);
+    free(cache->nodePrev);
+    memset(cache, 0, sizeof(*cache));
+}
+
+void ResetTrajectoryStats(TrajectoryCache *cache) {
+    cache->predictions   = 0;
+    cache->invalidations = 0;
+}
+
+// ----------------------------------------------------------------------
+//  Block dependency lists
+// ----------------------------------------------------------------------
+static void LinkNode(TrajectoryCache *cache, int block, int node) {
+    int head = cache->blockHeads[block];
+    cache->nodePrev[node] = -1;
+    cache->nodeNext[node] = head;
+    if (head >= 0) cache->nodePrev[head] = node;
+    cache->blockHeads[block] = node;
+}
+
+static void UnlinkNode(TrajectoryCache *cache, int block, int node) {
+    int prev = cache->nodePrev[node];
+    int next = cache->nodeNext[node];
+    if (prev >= 0) cache->nodeNext[prev] = next;
+    else cache->blockHeads[block] = next;
+    if (next >= 0) cache->nodePrev[next] = prev;
+}
+
+static void ReleasePath(TrajectoryCache *cache, int slot) {
+    TrajectoryPath *path = &cache->paths[slot];
+    for (int p = 0; p < path->pointCount; p++) {
+        if (path->blocks[p] >= 0) UnlinkNode(cache, path->blocks[p], slot * TRAJECTORY_MAX_POINTS + p);
+    }
+    path->valid = false;
+}
+
+void InvalidateTrajectory(TrajectoryCache *cache, int slot) {
+    if (slot < 0 || slot >= cache->capacity || !cache->paths[slot].valid) return;
+    ReleasePath(cache, slot);
+    cache->invalidations++;
+}
+
+void InvalidateBlockTrajectories(TrajectoryCache *cache, const LevelData *level, int blockIndex) {
+    if (blockIndex < 0 || blockIndex >= cache->blockCount) return;
+    const Block *block = &level->blocks[blockIndex];
+
+    // Gone: only the paths that bounced off it change. Each invalidation
+    // takes at least the head off the list.
+    if (!block->active) {
+        while (cache->blockHeads[blockIndex] >= 0) {
+            InvalidateTrajectory(cache, cache->blockHeads[blockIndex] / TRAJECTORY_MAX_POINTS);
+        }
+        return;
+    }
+
+    // Back: any path crossing it now stops short
+    for (int slot = 0; slot < cache->capacity; slot++) {
+        const TrajectoryPath *path = &cache->paths[slot];
+        if (!path->valid) continue;
+        for (int p = 0; p + 1 < path->pointCount; p++) {
+            Vector2 span = { path->points[p + 1].x - path->points[p].x, path->points[p + 1].y - path->points[p].y };
+            if (RayHitsRect(path->points[p], span, block->rect, path->radius, 1.0f) != NO_HIT) {
+                InvalidateTrajectory(cache, slot);
+                break;
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------
+//  Prediction
+// ----------------------------------------------------------------------
+
+// First active block in the way within tMax, skipping the one just left
+static float FindBlockHit(const TrajectoryCache *cache, const LevelData *level, Vector2 p, Vector2 v,
+                          float radius, float tMax, int skip, int *hitBlock) {
+    // Blocks sit at the top; a stretch that stays below them all meets none
+    float lowestY = (v.y < 0.0f) ? p.y + v.y * tMax : p.y;
+    if (lowestY > cache->blocksBottom + radius) return NO_HIT;
+
+    float best = NO_HIT;
+    for (int i = 0; i < level->blockCount; i++) {
+        if (!level->blocks[i].active || i == skip) continue;
+        float t = RayHitsRect(p, v, level->blocks[i].rect, radius, (best < tMax) ? best : tMax);
+        if (t < best) {
+            best      = t;
+            *hitBlock = i;
+        }
+    }
+    return best;
+}
+
+const TrajectoryPath *PredictTrajectory(TrajectoryCache *cache, int slot, uint32_t key, const LevelData *level,
+                                        Vector2 position, Vector2 velocity, float radius, double now) {
+    if (slot < 0 || slot >= cache->capacity) return NULL;
+    TrajectoryPath *path = &cache->paths[slot];
+    if (path->valid) ReleasePath(cache, slot);
+
+    path->key         = key;
+    path->valid       = true;
+    path->reachesLine = false;
+    path->radius      = radius;
+    path->startTime   = now;
+    path->points[0]   = position;
+    path->times[0]    = 0.0f;
+    path->blocks[0]   = -1;
+    path->pointCount  = 1;
+    cache->predictions++;
+
+    // A resting ball stays where it is until something moves it
+    if (velocity.x == 0.0f && velocity.y == 0.0f) return path;
+
+    Vector2 p = position, v = velocity;
+    float t = 0.0f;
+    int lastBlock = -1;
+    float right = cache->width - radius;
+
+    while (path->pointCount < cache->maxBounces + 2) {
+        // Nearest of paddle line, side wall, ceiling and block
+        float tLine = NO_HIT, tWall = NO_HIT, tCeiling = NO_HIT;
+        if (v.y > 0.0f) tLine = fmaxf((cache->lineY - p.y) / v.y, 0.0f);
+        if (v.y < 0.0f) tCeiling = fmaxf((p.y - radius) / -v.y, 0.0f);
+        if (v.x < 0.0f) tWall = fmaxf((p.x - radius) / -v.x, 0.0f);
+        if (v.x > 0.0f) tWall = fmaxf((right - p.x) / v.x, 0.0f);
+
+        float step = fminf(tLine, fminf(tWall, tCeiling));
+        int block = -1;
+        float tBlock = FindBlockHit(cache, level, p, v, radius, step, lastBlock, &block);
+        if (tBlock <= step) step = tBlock;
+        else block = -1;
+        if (step == NO_HIT) break;
+
+        p.x += v.x * step;
+        p.y += v.y * step;
+        t   += step;
+
+        int point = path->pointCount++;
+        path->points[point] = p;
+        path->times[point]  = t;
+        path->blocks[point] = block;
+
+        if (block >= 0) {
+            LinkNode(cache, block, slot * TRAJECTORY_MAX_POINTS + point);
+            v.y = -v.y;
+        }
+        else if (step == tLine) {
+            path->reachesLine = true;
+            break;
+        }
+        else if (step == tWall) {
+            v.x = -v.x;
+        }
+        else {
+            v.y = -v.y;
+        }
+        lastBlock = block;
+    }
+    return path;
+}
+
+const TrajectoryPath *GetTrajectory(const TrajectoryCache *cache, int slot, uint32_t key, double now) {
+    if (slot < 0 || slot >= cache->capacity) return NULL;
+    const TrajectoryPath *path = &cache->paths[slot];
+    if (!path->valid || path->key != key) return NULL;
+
+    // Good until the ball reaches its first bounce
+    if (path->pointCount > 1 && now >= path->startTime + path->times[1]) return NULL;
+    return path;
+}
+
+const TrajectoryPath *UpdateTrajectory(TrajectoryCache *cache, int slot, uint32_t key, const LevelData *level,
+                                       Vector2 position, Vector2 velocity, float radius, double now) {
+    const TrajectoryPath *path = GetTrajectory(cache, slot, key, now);
+    if (path) return path;
+    return PredictTrajectory(cache, slot, key, level, position, velocity, radius, now);
+}
+
+void TrajectoryStateAt(const TrajectoryPath *path, double now, Vector2 *position, Vector2 *velocity) {
+    if (path->pointCount < 2) {
+        *position = path->points[0];
+        *velocity = (Vector2){ 0.0f, 0.0f };
+        return;
+    }
+
+    float t = (float)(now - path->startTime);
+    int p = 0;
+    while (p + 2 < path->pointCount && t >= path->times[p + 1]) p++;
+
+    Vector2 from = path->points[p], to = path->points[p + 1];
+    float span = path->times[p + 1] - path->times[p];
+    if (span <= 0.0f) {
+        *position = to;
+        *velocity = (Vector2){ 0.0f, 0.0f };
+        return;
+    }
+    *velocity = (Vector2){ (to.x - from.x) / span, (to.y - from.y) / span };
+
+    float along = t - path->times[p];
+    if (along > span) along = span;
+    if (along < 0.0f) along = 0.0f;
+    *position = (Vector2){ from.x + velocity->x * along, from.y + velocity->y * along };
+}
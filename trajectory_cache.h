@@ -0,0 +1,90 @@
+#ifndef TRAJECTORY_CACHE_H
+#define TRAJECTORY_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "raylib.h"
+#include "level.h"
+
+#define TRAJECTORY_MAX_BOUNCES 8
+#define TRAJECTORY_MAX_POINTS  (TRAJECTORY_MAX_BOUNCES + 2)   // start, bounces, end
+
+// ----------------------------------------------------------------------
+//  Predicted ball paths, kept until something makes them wrong
+//
+//  A path runs from the ball through up to maxBounces bounces (side walls,
+//  ceiling and blocks, which reverse the vertical speed as in game) and
+//  ends on the paddle line. It stays current until the ball passes its
+//  first bounce, when it is predicted again from the live ball, which
+//  keeps frame-step drift out of it. In between only these make it stale:
+//    - the ball itself bounced off a block or the paddle
+//    - a block the path bounces off was destroyed (per-block lists, so
+//      only those balls are touched)
+//    - a block came back across the path (checks every current path, but
+//      respawns are rare)
+//
+//  Paths live in slots the caller picks, e.g. entity slots; the key stored
+//  with a path tells a reused slot from the ball that was there before.
+//  Times are on the caller's clock, which should be ball time (frame time
+//  times any speed scaling) so a slowed ball's path does not go stale early.
+// ----------------------------------------------------------------------
+typedef struct TrajectoryPath {
+    uint32_t key;                           // 0 for an empty slot
+    bool valid;
+    bool reachesLine;                       // ends on the paddle line, not the bounce limit
+    int pointCount;
+    float radius;
+    double startTime;
+    Vector2 points[TRAJECTORY_MAX_POINTS];
+    float times[TRAJECTORY_MAX_POINTS];     // after startTime
+    int blocks[TRAJECTORY_MAX_POINTS];      // block bounced off at each point, -1 otherwise
+} TrajectoryPath;
+
+typedef struct TrajectoryCache {
+    int capacity;
+    int maxBounces;
+    float width;                            // walls at 0 and width, ceiling at 0
+    float lineY;                            // paddle line, where paths end
+    float blocksBottom;                     // lowest block edge, below it no scan is needed
+    int blockCount;
+    TrajectoryPath *paths;
+
+    // Who bounces off each block: doubly linked lists through one node per
+    // path point, node = slot * TRAJECTORY_MAX_POINTS + point
+    int *blockHeads;
+    int *nodeNext;
+    int *nodePrev;
+
+    int predictions;                        // since the last ResetTrajectoryStats
+    int invalidations;
+} TrajectoryCache;
+
+// Blocks are taken from level; their rects must not move while the cache is
+// in use. maxBounces is clamped to TRAJECTORY_MAX_BOUNCES.
+bool InitTrajectoryCache(TrajectoryCache *cache, int capacity, const LevelData *level,
+                         float width, float lineY, int maxBounces);
+void FreeTrajectoryCache(TrajectoryCache *cache);
+
+// Path in slot if it belongs to key and is still good at now, else NULL
+const TrajectoryPath *GetTrajectory(const TrajectoryCache *cache, int slot, uint32_t key, double now);
+
+// Predicts from the ball's current state and stores the result in slot
+const TrajectoryPath *PredictTrajectory(TrajectoryCache *cache, int slot, uint32_t key, const LevelData *level,
+                                        Vector2 position, Vector2 velocity, float radius, double now);
+
+// GetTrajectory, predicting only when there is nothing current
+const TrajectoryPath *UpdateTrajectory(TrajectoryCache *cache, int slot, uint32_t key, const LevelData *level,
+                                       Vector2 position, Vector2 velocity, float radius, double now);
+
+void InvalidateTrajectory(TrajectoryCache *cache, int slot);
+
+// Call after a block is destroyed or comes back
+void InvalidateBlockTrajectories(TrajectoryCache *cache, const LevelData *level, int blockIndex);
+
+// Where the path has the ball at now, and its velocity there. Past the last
+// point the ball is left at it.
+void TrajectoryStateAt(const TrajectoryPath *path, double now, Vector2 *position, Vector2 *velocity);
+
+void ResetTrajectoryStats(TrajectoryCache *cache);
+
+#endif // TRAJECTORY_CACHE_H